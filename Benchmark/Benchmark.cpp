@@ -0,0 +1,846 @@
+#include "DelegateLib.h"
+#include "StateMachine.h"
+#include "EventBus.h"
+#include "StateMachineRegistry.h"
+#include "StateProfiler.h"
+#include "StatePublisher.h"
+#include "WorkerThreadStd.h"
+#include "ThreadPool.h"
+#include "Strand.h"
+#include "StallWatchdog.h"
+#include "MetricsExporter.h"
+#include "PerfCounters.h"
+#include "TransitionJournal.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Performance harness for the state machine and delegate library. Each benchmark
+// reports the time per operation and, where the platform permits, hardware and
+// software performance counters per operation measured on the calling thread.
+//
+// Usage: DelegateBenchmark [iteration scale]
+
+using namespace std;
+using namespace DelegateLib;
+
+// Scale factor applied to each benchmark iteration count
+static uint64_t scale = 1;
+
+//------------------------------------------------------------------------------
+// BenchStateMachine - minimal two state machine. Each Toggle() call is a single
+// StateEngine transition.
+//------------------------------------------------------------------------------
+class BenchStateMachine : public StateMachine
+{
+public:
+	BenchStateMachine() : StateMachine(ST_MAX_STATES) {}
+
+	void Toggle(const NoEventData* data = NULL)
+	{
+		BEGIN_TRANSITION_MAP			              			// - Current State -
+			TRANSITION_MAP_ENTRY (ST_OFF)						// ST_ON
+			TRANSITION_MAP_ENTRY (ST_ON)						// ST_OFF
+		END_TRANSITION_MAP(data)
+	}
+
+	UINT32 m_count = 0;
+
+	enum States
+	{
+		ST_ON,
+		ST_OFF,
+		ST_MAX_STATES
+	};
+
+	struct Counts
+	{
+		UINT32 count;
+	};
+
+	/// Publish the state and count after each transition, or stop publishing
+	void Publish(BOOL enable) { SetStatePublisher(enable ? &m_published : NULL); }
+
+	PublishedState<Counts> ReadPublished() const { return m_published.Read(); }
+
+private:
+	void CaptureCounts(Counts& counts) { counts.count = m_count; }
+
+	StatePublisher<BenchStateMachine, Counts, &BenchStateMachine::CaptureCounts> m_published;
+
+	STATE_DECLARE(BenchStateMachine, On, NoEventData)
+	STATE_DECLARE(BenchStateMachine, Off, NoEventData)
+
+	BEGIN_STATE_MAP
+		STATE_MAP_ENTRY(&On)
+		STATE_MAP_ENTRY(&Off)
+	END_STATE_MAP
+};
+
+STATE_DEFINE(BenchStateMachine, On, NoEventData) { m_count++; }
+STATE_DEFINE(BenchStateMachine, Off, NoEventData) { m_count++; }
+
+//------------------------------------------------------------------------------
+// ChainStateMachine - each Start() call runs a chain of CHAIN_LENGTH internal
+// events within one dispatch.
+//------------------------------------------------------------------------------
+class ChainStateMachine : public StateMachine
+{
+public:
+	enum { CHAIN_LENGTH = 10000 };
+
+	ChainStateMachine() : StateMachine(ST_MAX_STATES) {}
+
+	void Start()
+	{
+		BEGIN_TRANSITION_MAP			              			// - Current State -
+			TRANSITION_MAP_ENTRY (ST_STEP)						// ST_IDLE
+			TRANSITION_MAP_ENTRY (EVENT_IGNORED)				// ST_STEP
+		END_TRANSITION_MAP(NULL)
+	}
+
+private:
+	UINT32 m_remaining = 0;
+
+	enum States
+	{
+		ST_IDLE,
+		ST_STEP,
+		ST_MAX_STATES
+	};
+
+	STATE_DECLARE(ChainStateMachine, Idle, NoEventData)
+	STATE_DECLARE(ChainStateMachine, Step, NoEventData)
+
+	BEGIN_STATE_MAP
+		STATE_MAP_ENTRY(&Idle)
+		STATE_MAP_ENTRY(&Step)
+	END_STATE_MAP
+};
+
+STATE_DEFINE(ChainStateMachine, Idle, NoEventData) { }
+
+STATE_DEFINE(ChainStateMachine, Step, NoEventData)
+{
+	if (m_remaining == 0)
+		m_remaining = CHAIN_LENGTH;
+	if (--m_remaining > 0)
+		InternalEvent(ST_STEP);
+	else
+		InternalEvent(ST_IDLE);
+}
+
+static void NoOp(int) { }
+static void NoOpRef(const string&) { }
+
+// Fixed size event data and a variable size record with a zero-copy view
+struct BenchEventData : public EventData
+{
+	INT speed = 0;
+	INT pressure = 0;
+	UINT32 flags = 0;
+	SERIAL_FIELDS(speed, pressure, flags)
+};
+
+struct BenchRecord
+{
+	UINT32 id = 0;
+	string name;
+	std::vector<float> samples;
+	SERIAL_FIELDS(id, name, samples)
+};
+
+struct BenchRecordView
+{
+	UINT32 id = 0;
+	std::string_view name;
+	SerialSpan<float> samples;
+	SERIAL_FIELDS(id, name, samples)
+};
+
+static uint64_t serialSink = 0;
+static void SerialTarget(int value, const string& name, const BenchEventData* data)
+{
+	serialSink += value + name.size() + (data ? data->speed : 0);
+}
+
+// Subsystem query taking a fixed time on its own thread
+static int SlowQuery(int value)
+{
+	std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	return value;
+}
+
+// CPU bound handler for parallel broadcast
+static uint64_t Spin(uint64_t seed)
+{
+	for (int i = 0; i < 20000; i++)
+		seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+	return seed;
+}
+
+// Worker thread allocating dispatched arguments from the heap rather than its arena
+class HeapWorkerThread : public WorkerThread
+{
+public:
+	HeapWorkerThread(const string& name) : WorkerThread(name) { }
+	virtual shared_ptr<DelegateArena> GetArena() { return nullptr; }
+};
+
+// Queueing delay of probe messages sent behind a long event chain
+static uint64_t probeTotalNs = 0;
+static uint64_t probeMaxNs = 0;
+
+static uint64_t GetTimeNs()
+{
+	return uint64_t(chrono::duration_cast<chrono::nanoseconds>(
+		chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Holds the worker thread until the chain and probe are both queued, then
+// records when the chain starts
+static atomic<bool> gateOpen(false);
+static uint64_t gateOpenNs = 0;
+
+static void Gate()
+{
+	while (!gateOpen.load())
+		this_thread::yield();
+	gateOpenNs = GetTimeNs();
+}
+
+static void Probe()
+{
+	uint64_t delay = GetTimeNs() - gateOpenNs;
+	probeTotalNs += delay;
+	probeMaxNs = max(probeMaxNs, delay);
+}
+
+// Delay from a quiet producer's dispatch to its invoke, behind a flooding producer
+static uint64_t quietTotalNs = 0;
+static uint64_t quietMaxNs = 0;
+static void QuietProbe(uint64_t sentNs)
+{
+	uint64_t delay = GetTimeNs() - sentNs;
+	quietTotalNs += delay;
+	quietMaxNs = max(quietMaxNs, delay);
+}
+
+// Target that stalls its worker thread
+static void Stall(int ms)
+{
+	this_thread::sleep_for(chrono::milliseconds(ms));
+}
+
+static void PrintStall(const StallReport& report)
+{
+	printf("Stall on %s: %s running %.1f ms, %u queued\n", report.threadName.c_str(), report.target.c_str(),
+		report.durationNs / 1e6, (unsigned)report.queueSize);
+}
+
+// Number of state machines receiving each broadcast event
+static const int BROADCAST_MACHINES = 16;
+
+//------------------------------------------------------------------------------
+// RunBenchmark
+//------------------------------------------------------------------------------
+template <class Func>
+static void RunBenchmark(const char* name, uint64_t ops, Func func)
+{
+	PerfCounters counters;
+
+	auto start = chrono::steady_clock::now();
+	counters.Start();
+	func(ops);
+	PerfCounters::Sample sample = counters.Stop();
+	auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+
+	printf("%-28s %10llu ops %10.1f ns/op", name, (unsigned long long)ops,
+		double(elapsed.count()) / double(ops));
+	for (int i = 0; i < PerfCounters::COUNTER_MAX; i++)
+	{
+		PerfCounters::Counter counter = PerfCounters::Counter(i);
+		double perOp = sample.PerOp(counter, ops);
+		if (perOp >= 0.0)
+			printf("  %s/op %.3f", PerfCounters::GetName(counter), perOp);
+	}
+	printf("\n");
+}
+
+//------------------------------------------------------------------------------
+// main
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	if (argc > 1)
+		scale = strtoull(argv[1], NULL, 10) > 0 ? strtoull(argv[1], NULL, 10) : 1;
+
+	PerfCounters probe;
+	if (!probe.IsAnyAvailable())
+		printf("Performance counters unavailable; reporting time only.\n");
+	for (int i = 0; i < PerfCounters::COUNTER_MAX; i++)
+	{
+		if (!probe.IsAvailable(PerfCounters::Counter(i)))
+			printf("Counter %s unavailable.\n", PerfCounters::GetName(PerfCounters::Counter(i)));
+	}
+
+	WorkerThread workerThread("BenchWorker");
+	workerThread.CreateThread();
+
+	BenchStateMachine sm;
+	RunBenchmark("StateEngine transition", 1000000 * scale, [&sm](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			sm.Toggle();
+	});
+
+	// The same transitions with each one appended to a mapped journal segment
+	TransitionJournal journal;
+	if (journal.Open("BenchJournal", 1 << 16))
+	{
+		sm.SetJournal(&journal, 1);
+		RunBenchmark("StateEngine + journal", 1000000 * scale, [&sm](uint64_t ops) {
+			for (uint64_t i = 0; i < ops; i++)
+				sm.Toggle();
+		});
+		sm.SetJournal(NULL, 0);
+		journal.Close();
+		printf("Journal records %llu dropped %llu\n", (unsigned long long)journal.GetAppendedCount(),
+			(unsigned long long)journal.GetDroppedCount());
+		remove("BenchJournal.snapshot");
+	}
+
+	StateProfiler::SetSampleInterval(64);
+	RunBenchmark("StateEngine + profiler", 1000000 * scale, [&sm](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			sm.Toggle();
+	});
+	StateProfiler::SetSampleInterval(0);
+	printf("%s", StateProfiler::GetReport(4).c_str());
+	StateProfiler::Reset();
+
+	// Transitions publishing state and count, first unobserved, then with another
+	// thread reading the published copy; every read must pair a state with its count
+	sm.Publish(TRUE);
+	RunBenchmark("StateEngine + publish", 1000000 * scale, [&sm](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			sm.Toggle();
+	});
+	{
+		atomic<bool> observing(true);
+		uint64_t reads = 0, torn = 0;
+		thread observer([&] {
+			while (observing.load(memory_order_relaxed))
+			{
+				PublishedState<BenchStateMachine::Counts> published = sm.ReadPublished();
+				if ((published.state == BenchStateMachine::ST_OFF) != ((published.fields.count & 1) != 0))
+					torn++;
+				reads++;
+			}
+		});
+		RunBenchmark("StateEngine + publish, observed", 1000000 * scale, [&sm](uint64_t ops) {
+			for (uint64_t i = 0; i < ops; i++)
+				sm.Toggle();
+		});
+		observing = false;
+		observer.join();
+		printf("Published state reads %llu inconsistent %llu\n", (unsigned long long)reads, (unsigned long long)torn);
+	}
+	sm.Publish(FALSE);
+
+	auto syncDelegate = MakeDelegate(&NoOp);
+	RunBenchmark("Sync delegate invoke", 1000000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			syncDelegate(int(i));
+	});
+
+	// Fire and forget dispatch, then a blocking call to drain the queue
+	auto asyncDelegate = MakeDelegate(&NoOp, workerThread);
+	auto fenceDelegate = MakeDelegate(&NoOp, workerThread, WAIT_INFINITE);
+	RunBenchmark("Async dispatch", 200000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			asyncDelegate(int(i));
+		fenceDelegate(0);
+	});
+
+	// The same calls with each message and argument copy allocated from the heap
+	HeapWorkerThread heapThread("BenchHeap");
+	heapThread.CreateThread();
+	auto heapDelegate = MakeDelegate(&NoOp, heapThread);
+	auto heapFenceDelegate = MakeDelegate(&NoOp, heapThread, WAIT_INFINITE);
+	RunBenchmark("Async dispatch (heap)", 200000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			heapDelegate(int(i));
+		heapFenceDelegate(0);
+	});
+
+	// A reference argument adds a heap copy and deleter per call without the arena
+	string text("arena argument");
+	auto refDelegate = MakeDelegate(&NoOpRef, workerThread);
+	RunBenchmark("Async dispatch const&", 200000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			refDelegate(text);
+		fenceDelegate(0);
+	});
+	auto heapRefDelegate = MakeDelegate(&NoOpRef, heapThread);
+	RunBenchmark("Async dispatch const& (heap)", 200000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			heapRefDelegate(text);
+		heapFenceDelegate(0);
+	});
+	printf("Arena blocks %u\n", (unsigned)workerThread.GetArena()->GetBlockCount());
+	heapThread.ExitThread();
+
+	// The same calls accumulated into batch messages
+	auto batchDelegate = MakeDelegateBatch(MakeDelegate(&NoOp), workerThread, 64);
+	RunBenchmark("Batched async dispatch", 200000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			batchDelegate(int(i));
+		fenceDelegate(0);
+	});
+	printf("Batch messages %llu\n", (unsigned long long)batchDelegate.GetMessageCount());
+
+	RunBenchmark("AsyncWait round trip", 20000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			fenceDelegate(int(i));
+	});
+
+	// Query four subsystems one AsyncWait at a time, then scattered and gathered
+	const int subsystemCount = 4;
+	std::vector<std::unique_ptr<WorkerThread>> subsystems;
+	for (int i = 0; i < subsystemCount; i++)
+	{
+		subsystems.emplace_back(new WorkerThread("BenchSubsystem" + to_string(i)));
+		subsystems.back()->CreateThread();
+	}
+	RunBenchmark("AsyncWait x4 sequential", 50 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			for (int s = 0; s < subsystemCount; s++)
+				MakeDelegate(&SlowQuery, *subsystems[s], WAIT_INFINITE)(s);
+	});
+	int gatherSum = 0;
+	RunBenchmark("AsyncWait x4 gather", 50 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+		{
+			DelegateGather gather;
+			std::vector<std::shared_ptr<DelegateFreeAsyncWait<int(int)>>> results;
+			for (int s = 0; s < subsystemCount; s++)
+				results.push_back(gather.Add(MakeDelegate(&SlowQuery, *subsystems[s], WAIT_INFINITE), s));
+			gather.Wait(std::chrono::milliseconds(100));
+			gatherSum = 0;
+			for (auto& result : results)
+				gatherSum += result->IsSuccess() ? result->GetRetVal() : -100;
+		}
+	});
+	printf("Gather sum %d\n", gatherSum);
+	for (auto& subsystem : subsystems)
+		subsystem->ExitThread();
+
+	// Time-triggered worker: a 1 ms and a 5 ms task with messages serviced in slack
+	WorkerThread cyclicThread("BenchCyclic");
+	atomic<uint64_t> fastPolls(0), slowPolls(0);
+	cyclicThread.SetCyclic(chrono::microseconds(1000));
+	cyclicThread.AddCyclicTask(MakeDelegate(std::function<void()>([&fastPolls] { fastPolls++; })), 1);
+	cyclicThread.AddCyclicTask(MakeDelegate(std::function<void()>([&slowPolls] { slowPolls++; })), 5, 2);
+	cyclicThread.CreateThread();
+	auto cyclicDelegate = MakeDelegate(&NoOp, cyclicThread);
+	auto cyclicFence = MakeDelegate(&NoOp, cyclicThread, WAIT_INFINITE);
+	RunBenchmark("Cyclic slack dispatch", 20000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			cyclicDelegate(int(i));
+		cyclicFence(0);
+	});
+	this_thread::sleep_for(chrono::milliseconds(200));
+	cyclicThread.ExitThread();
+	WorkerThread::CyclicStats cyclicStats = cyclicThread.GetCyclicStats();
+	printf("Cyclic frames %llu overruns %llu skipped %llu polls %llu/%llu jitter p50 %.1f us p99 %.1f us max %.1f us\n",
+		(unsigned long long)cyclicStats.frames, (unsigned long long)cyclicStats.overruns,
+		(unsigned long long)cyclicStats.skippedFrames, (unsigned long long)fastPolls.load(),
+		(unsigned long long)slowPolls.load(), cyclicStats.jitter.GetPercentile(50) / 1000.0,
+		cyclicStats.jitter.GetPercentile(99) / 1000.0, cyclicStats.jitter.GetMax() / 1000.0);
+
+	// A flooding producer and a quiet producer sharing one FIFO, then fair queues
+	for (int fair = 0; fair < 2; fair++)
+	{
+		WorkerThread sharedThread(fair ? "BenchFair" : "BenchFifo");
+		sharedThread.SetFairQueuing(fair != 0);
+		sharedThread.CreateThread();
+		auto floodDelegate = MakeDelegate(&NoOp, sharedThread);
+		auto quietDelegate = MakeDelegate(&QuietProbe, sharedThread);
+		quietTotalNs = quietMaxNs = 0;
+		const int probeCount = 100;
+		atomic<bool> flooding(true);
+		thread flooder([&] {
+			while (flooding)
+				for (int i = 0; i < 1000; i++)
+					floodDelegate(i);
+		});
+		for (int i = 0; i < probeCount; i++)
+		{
+			quietDelegate(GetTimeNs());
+			this_thread::sleep_for(chrono::microseconds(500));
+		}
+		flooding = false;
+		flooder.join();
+		sharedThread.ExitThread();
+		printf("%s quiet producer delay mean %.1f us max %.1f us\n", fair ? "Fair queues" : "FIFO queue ",
+			quietTotalNs / 1000.0 / probeCount, quietMaxNs / 1000.0);
+		for (const WorkerThread::ProducerStats& stats : sharedThread.GetProducerStats())
+			printf("  producer messages %llu max queued %u mean wait %.1f us\n", (unsigned long long)stats.messages,
+				(unsigned)stats.maxQueued, stats.meanWaitNs / 1000.0);
+	}
+
+	// Dispatch cost with the watchdog scanning, then a stalled target it reports
+	StallWatchdog watchdog;
+	watchdog.StallCallback += MakeDelegate(&PrintStall);
+	watchdog.Start(chrono::milliseconds(100));
+	RunBenchmark("Async dispatch + watchdog", 200000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			asyncDelegate(int(i));
+		fenceDelegate(0);
+	});
+	MakeDelegate(&Stall, workerThread)(300);
+	for (int i = 0; i < 10; i++)
+		asyncDelegate(i);
+	fenceDelegate(0);
+	watchdog.Stop();
+	printf("Stalls reported %llu\n", (unsigned long long)watchdog.GetStallCount());
+
+	// Cost of collecting one snapshot, then dispatch cost with metrics exported
+	// every 10 ms and the snapshot as a reader process sees it
+	MetricsExporter exporter;
+	exporter.CounterCallback += MakeDelegate(&StateProfiler::GetStateCounts);
+	RunBenchmark("Metrics snapshot", 2000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			exporter.Snapshot();
+	});
+	bool exporting = exporter.Start("/delegate_benchmark_metrics", chrono::milliseconds(10));
+	RunBenchmark("Async dispatch + metrics", 200000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			asyncDelegate(int(i));
+		fenceDelegate(0);
+	});
+	MetricsData metrics;
+	if (exporting && MetricsExporter::Read("/delegate_benchmark_metrics", metrics))
+		printf("%s", MetricsExporter::Format(metrics).c_str());
+	exporter.Stop();
+
+	// Flood with the worker's queued messages limited to 64 KB, first shedding
+	// then with backpressure on the producer
+	for (MessageBudget::Policy policy : { MessageBudget::DROP, MessageBudget::BLOCK })
+	{
+		MessageBudget& budget = workerThread.GetMessageBudget();
+		MessageBudget::Stats before = budget.GetStats();
+		budget.SetLimit(64 * 1024, policy);
+		RunBenchmark(policy == MessageBudget::DROP ? "Async dispatch, budget drop" : "Async dispatch, budget block",
+			200000 * scale, [&](uint64_t ops) {
+			for (uint64_t i = 0; i < ops; i++)
+				asyncDelegate(int(i));
+			fenceDelegate(0);
+		});
+		budget.SetLimit(0, MessageBudget::BLOCK);
+		MessageBudget::Stats after = budget.GetStats();
+		printf("Budget blocked %llu, dropped %llu\n",
+			(unsigned long long)(after.blocked - before.blocked), (unsigned long long)(after.dropped - before.dropped));
+	}
+	MessageBudget::Stats global = MessageBudget::GetGlobal().GetStats();
+	printf("Global messages %llu, max queued %u bytes\n", (unsigned long long)global.messages, (unsigned)global.maxBytes);
+
+	// Delay of another message queued behind a long internal event chain, first
+	// run to completion then with the chain yielding every 256 transitions
+	ChainStateMachine chain;
+	auto chainDelegate = MakeDelegate(&chain, &ChainStateMachine::Start, workerThread);
+	auto gateDelegate = MakeDelegate(&Gate, workerThread);
+	auto probeDelegate = MakeDelegate(&Probe, workerThread);
+	for (UINT32 budget : { 0u, 256u })
+	{
+		chain.SetRunBudget(budget ? &workerThread : NULL, budget);
+		probeTotalNs = probeMaxNs = 0;
+		RunBenchmark(budget ? "Event chain, budget 256" : "Event chain, no budget", 200 * scale, [&](uint64_t ops) {
+			for (uint64_t i = 0; i < ops; i++)
+			{
+				gateOpen = false;
+				gateDelegate();
+				chainDelegate();
+				probeDelegate();
+				gateOpen = true;
+
+				// Wait until a fence passes without the chain yielding again
+				UINT32 trips;
+				do
+				{
+					trips = chain.GetBudgetTripCount();
+					fenceDelegate(0);
+				} while (trips != chain.GetBudgetTripCount());
+			}
+		});
+		printf("Probe delay mean %.1f us max %.1f us, budget trips %u\n",
+			double(probeTotalNs) / 1000.0 / double(200 * scale), double(probeMaxNs) / 1000.0,
+			(unsigned)chain.GetBudgetTripCount());
+	}
+
+	// Deliver one event to many machines on the same thread: one async delegate
+	// per machine versus one EventBus message per thread
+	BenchStateMachine machines[BROADCAST_MACHINES];
+	MulticastDelegateSafe<void(const NoEventData*)> multicast;
+	EventBus bus;
+	for (int i = 0; i < BROADCAST_MACHINES; i++)
+	{
+		multicast += MakeDelegate(&machines[i], &BenchStateMachine::Toggle, workerThread);
+		bus.Subscribe(&machines[i], &BenchStateMachine::Toggle, workerThread, i);
+	}
+
+	RunBenchmark("Multicast broadcast x16", 20000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			multicast(NULL);
+		fenceDelegate(0);
+	});
+
+	// Status for one unit: each subscriber filters on its own thread versus a
+	// predicate evaluated on the publishing thread
+	MulticastDelegateSafe<void(int)> unitStatus;
+	MulticastDelegateSafe<void(int)> unitStatusFiltered;
+	for (int i = 0; i < BROADCAST_MACHINES; i++)
+	{
+		unitStatus += MakeDelegate(&NoOp, workerThread);
+		unitStatusFiltered += MakeDelegateFilter(MakeDelegate(&NoOp, workerThread),
+			[i](const int& unit) { return unit == i; });
+	}
+
+	RunBenchmark("Unit status x16", 20000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			unitStatus(int(i % BROADCAST_MACHINES));
+		fenceDelegate(0);
+	});
+
+	RunBenchmark("Unit status x16 filtered", 20000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			unitStatusFiltered(int(i % BROADCAST_MACHINES));
+		fenceDelegate(0);
+	});
+
+	// Route to one of many subscribers: predicates checked per subscriber versus
+	// a topic trie walk. Synchronous targets isolate the routing cost.
+	const int topicCount = 1024;
+	MulticastDelegateSafe<void(int)> unitPredicates;
+	TopicRouter<void(int)> unitTopics;
+	std::vector<std::string> topics;
+	for (int i = 0; i < topicCount; i++)
+	{
+		topics.push_back("unit/" + std::to_string(i) + "/status");
+		unitPredicates += MakeDelegateFilter(MakeDelegate(&NoOp), [i](const int& unit) { return unit == i; });
+		unitTopics.Subscribe(topics.back(), MakeDelegate(&NoOp));
+	}
+	unitTopics.Subscribe("unit/+/alarm", MakeDelegate(&NoOp));
+
+	RunBenchmark("Predicate route x1024", 200000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			unitPredicates(int(i % topicCount));
+	});
+
+	RunBenchmark("Topic route x1024", 200000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			unitTopics.Publish(topics[i % topicCount], int(i));
+	});
+
+	NoEventData event;
+	RunBenchmark("EventBus broadcast x16", 20000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			bus.Publish(event);
+		fenceDelegate(0);
+	});
+
+	RunBenchmark("EventBus publish to id", 200000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			bus.Publish(event, INT(i % BROADCAST_MACHINES));
+		fenceDelegate(0);
+	});
+
+	bus.Unsubscribe(&machines[0]);
+	for (int i = 1; i < BROADCAST_MACHINES; i++)
+		bus.Unsubscribe<NoEventData>(&machines[i]);
+
+	// Machine id lookup: a mutex protected unordered_map versus the registry
+	const UINT32 registryCount = 100000;
+	std::unordered_map<UINT32, StateMachine*> machineMap;
+	std::mutex machineMapLock;
+	StateMachineRegistry registry;
+	for (UINT32 i = 0; i < registryCount; i++)
+	{
+		machineMap[i] = &machines[i % BROADCAST_MACHINES];
+		registry.Add(i, &machines[i % BROADCAST_MACHINES], &workerThread);
+	}
+
+	StateMachine* found = NULL;
+	RunBenchmark("Locked map lookup", 1000000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+		{
+			std::lock_guard<std::mutex> lock(machineMapLock);
+			found = machineMap.find(UINT32(i * 7919 % registryCount))->second;
+		}
+	});
+
+	RunBenchmark("Registry lookup", 1000000 * scale, [&](uint64_t ops) {
+		StateMachineRegistry::Entry entry;
+		for (uint64_t i = 0; i < ops; i++)
+		{
+			registry.Find(UINT32(i * 7919 % registryCount), entry);
+			found = entry.machine;
+		}
+	});
+
+	RunBenchmark("Registry dispatch", 200000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			registry.Dispatch(UINT32(i % registryCount), &BenchStateMachine::Toggle, (const NoEventData*)NULL);
+		fenceDelegate(0);
+	});
+
+	for (UINT32 i = 0; i < registryCount; i++)
+		registry.Remove(i, i + 1 == registryCount);
+	printf("Registry count %u found %p\n", (unsigned)registry.GetCount(), (void*)found);
+
+	// The same async dispatch to a strand on a shared pool
+	ThreadPool pool("BenchPool");
+	pool.CreateThreads(2);
+	Strand strand(pool);
+	auto strandDelegate = MakeDelegate(&NoOp, strand);
+	auto strandFence = MakeDelegate(&NoOp, strand, WAIT_INFINITE);
+	RunBenchmark("Strand dispatch", 200000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			strandDelegate(int(i));
+		strandFence(0);
+	});
+
+	// One message to each of many idle strands
+	const size_t strandCount = 100000;
+	std::vector<std::unique_ptr<Strand>> strands;
+	for (size_t i = 0; i < strandCount; i++)
+		strands.emplace_back(new Strand(pool));
+	printf("sizeof(Strand) %u bytes\n", (unsigned)sizeof(Strand));
+	RunBenchmark("Strand fan-out x100000", strandCount, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+		{
+			strandDelegate.Bind(&NoOp, *strands[i]);
+			strandDelegate(int(i));
+		}
+		for (uint64_t i = 0; i < ops; i++)
+			while (strands[i]->GetQueueSize() != 0)
+				std::this_thread::yield();
+	});
+
+	// CPU bound handlers run serially on the caller, then across pool strands
+	const size_t handlerCount = 8;
+	MulticastDelegate<uint64_t(uint64_t)> handlers;
+	for (size_t i = 0; i < handlerCount; i++)
+		handlers += MakeDelegate(&Spin);
+	std::vector<std::unique_ptr<Strand>> helperStrands;
+	std::vector<DelegateThread*> helpers;
+	for (unsigned i = 0; i < pool.GetThreadCount(); i++)
+	{
+		helperStrands.emplace_back(new Strand(pool));
+		helpers.push_back(helperStrands.back().get());
+	}
+	RunBenchmark("Broadcast x8 CPU bound", 200 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			handlers(i);
+	});
+	RunBenchmark("ParallelBroadcast x8", 200 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			handlers.ParallelBroadcast(helpers, 0, i);
+	});
+	std::vector<uint64_t> gathered = handlers.ParallelGather(helpers, 2, 1);
+	printf("Gathered %u results, all equal %d\n", (unsigned)gathered.size(),
+		(int)(std::count(gathered.begin(), gathered.end(), Spin(1)) == (long)gathered.size()));
+	pool.ExitThreads();
+
+	// Encode and decode event data into a stack buffer, a record into an
+	// allocated buffer, and a delegate call's arguments
+	BenchEventData eventData;
+	eventData.speed = 100;
+	RunBenchmark("Serialize fixed EventData", 1000000 * scale, [&](uint64_t ops) {
+		std::uint8_t buffer[serial_traits<BenchEventData>::SIZE];
+		BenchEventData decoded;
+		for (uint64_t i = 0; i < ops; i++)
+		{
+			eventData.flags = UINT32(i);
+			SerialWriter writer(buffer, sizeof(buffer));
+			SerialWrite(writer, eventData);
+			Deserialize(buffer, sizeof(buffer), decoded);
+			serialSink += decoded.flags;
+		}
+	});
+	BenchRecord record;
+	record.name = "centrifuge speed samples";
+	record.samples.resize(256, 1.0f);
+	RunBenchmark("Serialize record", 1000000 * scale, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			serialSink += Serialize(record).size();
+	});
+	std::vector<std::uint8_t> recordBytes = Serialize(record);
+	RunBenchmark("Deserialize record", 1000000 * scale, [&](uint64_t ops) {
+		BenchRecord decoded;
+		for (uint64_t i = 0; i < ops; i++)
+		{
+			Deserialize(recordBytes.data(), recordBytes.size(), decoded);
+			serialSink += decoded.samples.size();
+		}
+	});
+	RunBenchmark("Deserialize record view", 1000000 * scale, [&](uint64_t ops) {
+		BenchRecordView decoded;
+		for (uint64_t i = 0; i < ops; i++)
+		{
+			Deserialize(recordBytes.data(), recordBytes.size(), decoded);
+			serialSink += decoded.samples.size();
+		}
+	});
+	typedef SerialArgs<int, const string&, const BenchEventData*> BenchArgs;
+	string argName = "speed";
+	RunBenchmark("Serialize args + invoke", 1000000 * scale, [&](uint64_t ops) {
+		std::uint8_t buffer[64];
+		BenchArgs args;
+		for (uint64_t i = 0; i < ops; i++)
+		{
+			SerialWriter writer(buffer, sizeof(buffer));
+			BenchArgs::Write(writer, int(i), argName, &eventData);
+			SerialReader reader(buffer, writer.GetSize());
+			if (args.Read(reader))
+				args.Invoke(&SerialTarget);
+		}
+	});
+	printf("Record %u bytes, fixed EventData %u bytes, sink %llu\n", (unsigned)recordBytes.size(),
+		(unsigned)serial_traits<BenchEventData>::SIZE, (unsigned long long)serialSink);
+
+	// Startup and shutdown cost per worker, one at a time and then as a group
+	const size_t workerCount = 256;
+	std::vector<std::unique_ptr<WorkerThread>> workers;
+	std::vector<WorkerThread*> group;
+	for (size_t i = 0; i < workerCount; i++)
+	{
+		workers.emplace_back(new WorkerThread("BenchStartup"));
+		group.push_back(workers.back().get());
+	}
+	RunBenchmark("Worker CreateThread", workerCount, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			group[i]->CreateThread();
+	});
+	RunBenchmark("Worker ExitThread", workerCount, [&](uint64_t ops) {
+		for (uint64_t i = 0; i < ops; i++)
+			group[i]->ExitThread();
+	});
+	RunBenchmark("Worker group CreateThreads", workerCount, [&](uint64_t) {
+		WorkerThread::CreateThreads(group);
+	});
+	RunBenchmark("Worker group ExitThreads", workerCount, [&](uint64_t) {
+		WorkerThread::ExitThreads(group);
+	});
+
+	workerThread.ExitThread();
+	return 0;
+}
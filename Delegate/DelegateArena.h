@@ -0,0 +1,229 @@
+#ifndef _DELEGATE_ARENA_H
+#define _DELEGATE_ARENA_H
+
+/// @file
+/// @brief Block arena for messages dispatched to one destination thread.
+///
+/// @details Without an arena, each asynchronous invocation allocates the
+/// message, its shared pointer control block and one copy per argument from
+/// the heap on the source thread, and the destination thread frees them after
+/// the invoke. Every message therefore crosses threads through the global
+/// allocator.
+///
+/// A `DelegateArena` is owned by a destination thread. Source threads
+/// bump-allocate messages from the arena's current block. A block counts its
+/// live allocations; releasing a message on the destination thread only
+/// decrements the count. Once a block is full and every message within it has
+/// been released, the whole block returns to the arena's free list for reuse.
+/// Neither thread calls the global allocator in the steady state.
+///
+/// Allocations larger than a quarter of the block size fall back to the heap.
+/// Blocks are not returned to the heap until the arena is destroyed, so the
+/// arena retains memory for the deepest queue it has seen.
+
+#include "DelegateOpt.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace DelegateLib {
+
+/// @brief Thread-safe block arena. Allocate from any thread; release from any
+/// thread. Use `ArenaAllocator<>` to allocate objects.
+class DelegateArena
+{
+public:
+    /// Constructor
+    /// @param[in] blockSize The usable bytes within each block.
+    explicit DelegateArena(std::size_t blockSize = 32 * 1024) : m_blockSize(RoundUp(blockSize)) { }
+
+    /// Destructor. Every allocation must be released before the arena is destroyed.
+    ~DelegateArena() {
+        if (m_current)
+            m_current->next = m_free;
+        Block* block = m_current ? m_current : m_free;
+        while (block) {
+            Block* next = block->next;
+            ::operator delete(block);
+            block = next;
+        }
+    }
+
+    DelegateArena(const DelegateArena&) = delete;
+    DelegateArena& operator=(const DelegateArena&) = delete;
+
+    /// Allocate memory aligned to `std::max_align_t`.
+    /// @param[in] size The number of bytes.
+    /// @return The memory, or nullptr if out of memory.
+    void* Allocate(std::size_t size) {
+        std::size_t bytes = sizeof(Header) + RoundUp(size);
+        if (bytes > m_blockSize / 4)
+            return Heap(bytes);
+
+        Block* block;
+        std::size_t offset;
+        {
+            const std::lock_guard<std::mutex> lock(m_lock);
+            if (!m_current || m_current->offset + bytes > m_blockSize) {
+                if (!NextBlock())
+                    return Heap(bytes);
+            }
+            block = m_current;
+            offset = block->offset;
+            block->offset += bytes;
+            block->live.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Header* header = reinterpret_cast<Header*>(reinterpret_cast<char*>(block + 1) + offset);
+        header->block = block;
+        return header + 1;
+    }
+
+    /// Release memory returned by `Allocate()`.
+    /// @param[in] p The memory to release.
+    static void Deallocate(void* p) noexcept {
+        if (!p)
+            return;
+        Header* header = static_cast<Header*>(p) - 1;
+        Block* block = header->block;
+        if (!block) {
+            ::operator delete(header);
+            return;
+        }
+
+        // The last release of a full block recycles it
+        if (block->live.fetch_sub(1) == 1 && block->retired.load())
+            block->arena->Recycle(block);
+    }
+
+    /// Get the number of blocks obtained from the heap.
+    std::size_t GetBlockCount() const noexcept { return m_blockCount.load(std::memory_order_relaxed); }
+
+private:
+    /// Block header. The block's memory follows the header.
+    struct alignas(std::max_align_t) Block {
+        DelegateArena* arena;
+        Block* next;
+        std::size_t offset;
+        std::atomic<std::size_t> live;
+        std::atomic<bool> retired;
+    };
+
+    /// Allocation header recording the owning block, or nullptr if heap allocated.
+    struct alignas(std::max_align_t) Header {
+        Block* block;
+    };
+
+    static std::size_t RoundUp(std::size_t size) noexcept {
+        const std::size_t align = alignof(std::max_align_t);
+        return (size + align - 1) & ~(align - 1);
+    }
+
+    static void* Heap(std::size_t bytes) noexcept {
+        Header* header = static_cast<Header*>(::operator new(bytes, std::nothrow));
+        if (!header)
+            return nullptr;
+        header->block = nullptr;
+        return header + 1;
+    }
+
+    /// Retire the current block and make a free or new block current. Called with
+    /// the lock held.
+    /// @return `false` if out of memory.
+    bool NextBlock() noexcept {
+        if (m_current) {
+            m_current->retired.store(true);
+            if (m_current->live.load() == 0)
+                Free(m_current);
+            m_current = nullptr;
+        }
+
+        Block* block = m_free;
+        if (block) {
+            m_free = block->next;
+        }
+        else {
+            block = static_cast<Block*>(::operator new(sizeof(Block) + m_blockSize, std::nothrow));
+            if (!block)
+                return false;
+            block->arena = this;
+            block->live.store(0, std::memory_order_relaxed);
+            block->retired.store(false, std::memory_order_relaxed);
+            m_blockCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        block->offset = 0;
+        block->next = nullptr;
+        m_current = block;
+        return true;
+    }
+
+    /// Return a retired block with no live allocations to the free list.
+    void Recycle(Block* block) noexcept {
+        const std::lock_guard<std::mutex> lock(m_lock);
+
+        // Either the retiring or the releasing thread may get here first
+        if (block->retired.load() && block->live.load() == 0)
+            Free(block);
+    }
+
+    /// Push a block onto the free list. Called with the lock held.
+    void Free(Block* block) noexcept {
+        block->retired.store(false);
+        block->next = m_free;
+        m_free = block;
+    }
+
+    const std::size_t m_blockSize;
+    std::mutex m_lock;
+    Block* m_current = nullptr;
+    Block* m_free = nullptr;
+    std::atomic<std::size_t> m_blockCount{ 0 };
+};
+
+/// @brief Standard allocator obtaining memory from a `DelegateArena`. Use with
+/// `std::allocate_shared()` to place an object and its control block within one
+/// arena allocation. The allocator shares ownership of the arena, so the arena
+/// outlives every object allocated from it.
+/// @tparam T The allocated type.
+template <class T>
+class ArenaAllocator
+{
+public:
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types not supported");
+
+    using value_type = T;
+
+    explicit ArenaAllocator(std::shared_ptr<DelegateArena> arena) noexcept : m_arena(std::move(arena)) { }
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& rhs) noexcept : m_arena(rhs.m_arena) { }
+
+    T* allocate(std::size_t n) {
+        void* p = m_arena->Allocate(n * sizeof(T));
+        if (!p)
+            BAD_ALLOC();
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        DelegateArena::Deallocate(p);
+    }
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>& rhs) const noexcept { return m_arena == rhs.m_arena; }
+
+    template <class U>
+    bool operator!=(const ArenaAllocator<U>& rhs) const noexcept { return m_arena != rhs.m_arena; }
+
+private:
+    template <class U>
+    friend class ArenaAllocator;
+
+    std::shared_ptr<DelegateArena> m_arena;
+};
+
+}
+
+#endif
@@ -36,7 +36,13 @@
 /// * `std::function` compares the function signature type, not the underlying object instance.
 /// See `DelegateFunction<>` class for more info.
 /// 
-/// Code within `<common_code>` and `</common_code>` is updated using sync_src.py. Manually update 
+/// The argument copy and destination thread invoke code lives in `DelegateAsyncBase<>`, 
+/// which is instantiated once per function signature and shared by the free, member 
+/// and `std::function` classes. Signature independent state and dispatch code lives in 
+/// the non-template `DelegateAsyncCore`. This limits the code generated per delegate 
+/// class to construction, comparison and the `operator()` entry point.
+/// 
+/// Code within `<common_code>` and `</common_code>` is updated using src_dup.py. Manually update 
 /// the code within the `DelegateFreeAsync` `common_code` tags, then run the script to 
 /// propagate to the remaining delegate classes to simplify code maintenance.
 /// 
@@ -46,6 +52,8 @@
 #include "DelegateThread.h"
 #include "DelegateInvoker.h"
 #include <tuple>
+#include <optional>
+#include <utility>
 
 namespace DelegateLib {
 
@@ -61,7 +69,9 @@ public:
     /// @param[in] args - a parameter pack of all target function arguments
     /// @throws std::bad_alloc If make_tuble_heap() fails to obtain memory and USE_ASSERTS not defined.
     DelegateAsyncMsg(std::shared_ptr<IDelegateInvoker> invoker, Args... args) : DelegateMsg(invoker),
-        m_args(make_tuple_heap(m_heapMem, m_start, std::forward<Args>(args)...)) { }
+        m_args(make_tuple_heap(m_heapMem, m_start, std::forward<Args>(args)...)) { 
+        SetSize(sizeof(DelegateAsyncMsg) + (heap_arg_size<Args>::value + ... + 0));
+    }
 
     virtual ~DelegateAsyncMsg() = default;
 
@@ -69,6 +79,13 @@ public:
     /// @return A tuple of all function arguments
     std::tuple<Args...>& GetArgs() { return m_args; }
 
+protected:
+    /// Constructor for a derived message storing the argument copies itself
+    /// @param[in] invoker - the invoker instance
+    /// @param[in] args - a tuple of arguments referencing the derived class copies
+    DelegateAsyncMsg(std::shared_ptr<IDelegateInvoker> invoker, std::tuple<Args...>&& args, std::true_type) :
+        DelegateMsg(invoker), m_args(std::move(args)) { }
+
 private:
     /// A list of heap allocated argument memory blocks
     xlist<std::shared_ptr<heap_arg_deleter_base>> m_heapMem;
@@ -80,6 +97,191 @@ private:
     std::tuple<Args...> m_args;
 };
 
+/// @brief Argument copy stored inline within a `DelegateArenaMsg`.
+/// @details By value arguments are held by the message tuple itself. A reference
+/// argument refers to a copy, and a pointer argument points to a copy, or is null.
+/// @tparam Arg A target function argument type.
+template <class Arg>
+struct arena_arg
+{
+    static constexpr bool supported = true;
+    struct storage { storage(const Arg&) { } };
+    static Arg get(storage&, Arg& arg) { return arg; }
+};
+
+template <class T>
+struct arena_arg<T&>
+{
+    static constexpr bool supported = true;
+    struct storage {
+        storage(T& arg) : value(arg) { }
+        std::remove_cv_t<T> value;
+    };
+    static T& get(storage& s, T&) { return s.value; }
+};
+
+template <class T>
+struct arena_arg<T*>
+{
+    static constexpr bool supported = !std::is_void_v<T> && !std::is_pointer_v<T>;
+    struct storage {
+        storage(T* arg) { if (arg) value.emplace(*arg); }
+        std::optional<std::remove_cv_t<T>> value;
+    };
+    static T* get(storage& s, T*) { return s.value ? &*s.value : nullptr; }
+};
+
+/// @brief Argument copies of a `DelegateArenaMsg`. A base class so the copies
+/// are constructed before the `DelegateAsyncMsg` tuple referencing them.
+template <class... Args>
+class DelegateArenaArgs
+{
+protected:
+    DelegateArenaArgs(std::add_lvalue_reference_t<Args>... args) : m_storage(args...) { }
+
+    using Storage = std::tuple<typename arena_arg<Args>::storage...>;
+
+    /// Make the message tuple referencing the copies.
+    template <std::size_t... Index>
+    static std::tuple<Args...> MakeArgs(Storage& storage, std::index_sequence<Index...>, std::add_lvalue_reference_t<Args>... args) {
+        return std::tuple<Args...>(arena_arg<Args>::get(std::get<Index>(storage), args)...);
+    }
+
+    Storage m_storage;
+};
+
+/// @brief Asynchronous message with the argument copies stored inline. Allocated
+/// as a single block from the destination thread's `DelegateArena`, replacing the
+/// per argument heap allocations of `DelegateAsyncMsg`. Pointer-to-pointer
+/// arguments are not supported; such messages use `DelegateAsyncMsg`.
+/// @tparam Args The argument types of the bound delegate function.
+template <class... Args>
+class DelegateArenaMsg : private DelegateArenaArgs<Args...>, public DelegateAsyncMsg<Args...>
+{
+public:
+    /// `true` if every argument type can be stored inline.
+    static constexpr bool supported = (arena_arg<Args>::supported && ...);
+
+    /// Constructor
+    /// @param[in] invoker - the invoker instance
+    /// @param[in] args - a parameter pack of all target function arguments
+    DelegateArenaMsg(std::shared_ptr<IDelegateInvoker> invoker, Args... args) :
+        DelegateArenaArgs<Args...>(args...),
+        DelegateAsyncMsg<Args...>(invoker,
+            DelegateArenaArgs<Args...>::MakeArgs(this->m_storage, std::index_sequence_for<Args...>(), args...), std::true_type()) { 
+        this->SetSize(sizeof(DelegateArenaMsg));
+    }
+};
+
+/// @brief Non-template state and dispatch code shared by all `Async` delegates 
+/// regardless of function signature.
+class DelegateAsyncCore
+{
+public:
+    ///@brief Get the destination thread that the target function is invoked on.
+    // @return The target thread.
+    DelegateThread* GetThread() noexcept { return m_thread; }
+
+protected:
+    /// @brief Dispatch a message onto the destination thread message queue. 
+    /// `Invoke()` will be called by the destination thread.
+    /// @param[in] msg The delegate message to dispatch.
+    void Dispatch(std::shared_ptr<DelegateMsg> msg) {
+        if (m_thread)
+            m_thread->DispatchDelegate(msg);
+    }
+
+    /// The target thread to invoke the delegate function.
+    DelegateThread* m_thread = nullptr;   
+
+    /// Flag to control synchronous vs asynchronous target invoke behavior.
+    bool m_sync = false;        
+};
+
+template <class R>
+struct DelegateAsyncBase; // Not defined
+
+/// @brief Asynchronous invoke machinery shared by all `Async` delegates with the 
+/// same function signature. 
+/// @details `DelegateFreeAsync`, `DelegateMemberAsync` and `DelegateFunctionAsync` 
+/// are thin shims over this class, so the argument copy and destination thread 
+/// invoke code is instantiated once per function signature rather than once per 
+/// delegate class.
+/// @tparam RetType The return type of the bound delegate function.
+/// @tparam Args The argument types of the bound delegate function.
+template <class RetType, class... Args>
+class DelegateAsyncBase<RetType(Args...)> : public IDelegateInvoker, public DelegateAsyncCore 
+{
+public:
+    /// @brief Invoke the delegate function on the destination thread. Called by the 
+    /// destintation thread.
+    /// @details Each source thread call to `operator()` generate a call to `Invoke()` 
+    /// on the destination thread. Unlike `DelegateAsyncWait`, a lock is not required between 
+    /// source and destination `delegateMsg` access because the source thread is not waiting 
+    /// for the function call to complete.
+    /// @param[in] msg The delegate message created and sent within `operator()(Args... args)`.
+    /// @return `true` if target function invoked; `false` if error. 
+    virtual bool Invoke(std::shared_ptr<DelegateMsg> msg) override {
+        // Typecast the base pointer to back correct derived to instance
+        auto delegateMsg = std::dynamic_pointer_cast<DelegateAsyncMsg<Args...>>(msg);
+        if (delegateMsg == nullptr)
+            return false;
+
+        // Invoke the delegate function synchronously
+        m_sync = true;
+
+        // Invoke the target function using the source thread supplied function arguments
+        std::apply(&DelegateAsyncBase::SyncInvoke, 
+            std::tuple_cat(std::make_tuple(this), delegateMsg->GetArgs()));
+        return true;
+    }
+
+protected:
+    /// @brief Copy the function arguments into a new message and dispatch onto the
+    /// destination thread. Called by the source thread.
+    /// @param[in] invoker The delegate clone that invokes the target on the destination thread.
+    /// @param[in] args The function arguments, if any.
+    /// @return A default return value. Do not use the return value.
+    /// @throws std::bad_alloc If dynamic memory allocation fails and USE_ASSERTS not defined.
+    RetType DispatchAsync(std::shared_ptr<IDelegateInvoker> invoker, Args... args) {
+        // Create a new message instance for sending to the destination thread. Allocate
+        // from the destination thread arena if available.
+        std::shared_ptr<DelegateAsyncMsg<Args...>> msg;
+        if constexpr (DelegateArenaMsg<Args...>::supported) {
+            std::shared_ptr<DelegateArena> arena = m_thread ? m_thread->GetArena() : nullptr;
+            if (arena)
+                msg = std::allocate_shared<DelegateArenaMsg<Args...>>(
+                    ArenaAllocator<DelegateArenaMsg<Args...>>(arena), invoker, args...);
+        }
+        if (!msg)
+            msg = std::make_shared<DelegateAsyncMsg<Args...>>(invoker, std::forward<Args>(args)...);
+        if (!msg)
+            BAD_ALLOC();
+
+        // Dispatch message onto the callback destination thread. Invoke()
+        // will be called by the destintation thread. 
+        Dispatch(msg);
+
+        // Do not wait for destination thread return value from async function call
+        return RetType();
+
+        // Check if any argument is a shared_ptr with wrong usage
+        // std::shared_ptr reference arguments are not allowed with asynchronous delegates as the behavior is 
+        // undefined. In other words:
+        // void MyFunc(std::shared_ptr<T> data)		// Ok!
+        // void MyFunc(std::shared_ptr<T>& data)	// Error if DelegateAsync or DelegateSpAsync target!
+        static_assert(!(std::disjunction_v<is_shared_ptr<Args>...> &&
+            (std::disjunction_v<std::is_lvalue_reference<Args>, std::is_pointer<Args>> || ...)),
+            "std::shared_ptr reference argument not allowed");
+    }
+
+    /// @brief Invoke the bound target function synchronously. Implemented by each 
+    /// delegate class to call its synchronous base class.
+    /// @param[in] args The function arguments, if any.
+    /// @return The bound function return value, if any.
+    virtual RetType SyncInvoke(Args... args) = 0;
+};
+
 template <class R>
 struct DelegateFreeAsync; // Not defined
 
@@ -87,7 +289,7 @@ struct DelegateFreeAsync; // Not defined
 /// @tparam RetType The return type of the bound delegate function.
 /// @tparam Args The argument types of the bound delegate function.
 template <class RetType, class... Args>
-class DelegateFreeAsync<RetType(Args...)> : public DelegateFree<RetType(Args...)>, public IDelegateInvoker {
+class DelegateFreeAsync<RetType(Args...)> : public DelegateFree<RetType(Args...)>, public DelegateAsyncBase<RetType(Args...)> {
 public:
     typedef RetType(*FreeFunc)(Args...);
     using ClassType = DelegateFreeAsync<RetType(Args...)>;
@@ -97,7 +299,7 @@ public:
     /// @param[in] func The target free function to store.
     /// @param[in] thread The execution thread to invoke `func`.
     DelegateFreeAsync(FreeFunc func, DelegateThread& thread) :
-        BaseType(func), m_thread(&thread) { 
+        BaseType(func) { 
         Bind(func, thread); 
     }
 
@@ -107,14 +309,15 @@ public:
     /// set the state of the new instance.
     /// @param[in] rhs The object to copy from.
     DelegateFreeAsync(const ClassType& rhs) :
-        BaseType(rhs), m_thread(rhs.m_thread) {
+        BaseType(rhs) {
         Assign(rhs);
     }
 
     /// @brief Move constructor that transfers ownership of resources.
     /// @param[in] rhs The object to move from.
     DelegateFreeAsync(ClassType&& rhs) noexcept : 
-        BaseType(rhs), m_thread(rhs.m_thread) {
+        BaseType(rhs) {
+        m_thread = rhs.m_thread;
         rhs.Clear();
     }
 
@@ -245,29 +448,9 @@ public:
             if (!delegate)
                 BAD_ALLOC();
 
-            // Create a new message instance for sending to the destination thread
-            auto msg = std::make_shared<DelegateAsyncMsg<Args...>>(delegate, std::forward<Args>(args)...);
-            if (!msg)
-                BAD_ALLOC();
-
-            auto thread = this->GetThread();
-            if (thread) {
-                // Dispatch message onto the callback destination thread. Invoke()
-                // will be called by the destintation thread. 
-                thread->DispatchDelegate(msg);
-            }
-
-            // Do not wait for destination thread return value from async function call
-            return RetType();
-
-            // Check if any argument is a shared_ptr with wrong usage
-            // std::shared_ptr reference arguments are not allowed with asynchronous delegates as the behavior is 
-            // undefined. In other words:
-            // void MyFunc(std::shared_ptr<T> data)		// Ok!
-            // void MyFunc(std::shared_ptr<T>& data)	// Error if DelegateAsync or DelegateSpAsync target!
-            static_assert(!(std::disjunction_v<is_shared_ptr<Args>...> &&
-                (std::disjunction_v<std::is_lvalue_reference<Args>, std::is_pointer<Args>> || ...)),
-                "std::shared_ptr reference argument not allowed");
+            // Dispatch a message with argument copies onto the destination thread. 
+            // Do not wait for destination thread return value from async function call.
+            return this->DispatchAsync(delegate, std::forward<Args>(args)...);
         }
     }
 
@@ -278,40 +461,18 @@ public:
         operator()(std::forward<Args>(args)...);
     }
 
-    /// @brief Invoke the delegate function on the destination thread. Called by the 
-    /// destintation thread.
-    /// @details Each source thread call to `operator()` generate a call to `Invoke()` 
-    /// on the destination thread. Unlike `DelegateAsyncWait`, a lock is not required between 
-    /// source and destination `delegateMsg` access because the source thread is not waiting 
-    /// for the function call to complete.
-    /// @param[in] msg The delegate message created and sent within `operator()(Args... args)`.
-    /// @return `true` if target function invoked; `false` if error. 
-    virtual bool Invoke(std::shared_ptr<DelegateMsg> msg) override {
-        // Typecast the base pointer to back correct derived to instance
-        auto delegateMsg = std::dynamic_pointer_cast<DelegateAsyncMsg<Args...>>(msg);
-        if (delegateMsg == nullptr)
-            return false;
-
-        // Invoke the delegate function synchronously
-        m_sync = true;
+protected:
+    using DelegateAsyncCore::m_thread;
+    using DelegateAsyncCore::m_sync;
 
-        // Invoke the target function using the source thread supplied function arguments
-        std::apply(&BaseType::operator(), 
-            std::tuple_cat(std::make_tuple(this), delegateMsg->GetArgs()));
-        return true;
+    /// @brief Invoke the bound target function synchronously. Called by `Invoke()` 
+    /// on the destination thread.
+    /// @param[in] args The function arguments, if any.
+    /// @return The bound function return value, if any.
+    virtual RetType SyncInvoke(Args... args) override {
+        return BaseType::operator()(std::forward<Args>(args)...);
     }
 
-    ///@brief Get the destination thread that the target function is invoked on.
-    // @return The target thread.
-    DelegateThread* GetThread() noexcept { return m_thread; }
-
-private:
-    /// The target thread to invoke the delegate function.
-    DelegateThread* m_thread = nullptr;   
-
-    /// Flag to control synchronous vs asynchronous target invoke behavior.
-    bool m_sync = false;        
-
     // </common_code>
 };
 
@@ -323,7 +484,7 @@ struct DelegateMemberAsync; // Not defined
 /// @tparam RetType The return type of the bound delegate function.
 /// @tparam Args The argument types of the bound delegate function.
 template <class TClass, class RetType, class... Args>
-class DelegateMemberAsync<TClass, RetType(Args...)> : public DelegateMember<TClass, RetType(Args...)>, public IDelegateInvoker {
+class DelegateMemberAsync<TClass, RetType(Args...)> : public DelegateMember<TClass, RetType(Args...)>, public DelegateAsyncBase<RetType(Args...)> {
 public:
     typedef TClass* ObjectPtr;
     typedef std::shared_ptr<TClass> SharedPtr;
@@ -336,7 +497,7 @@ public:
     /// @param[in] object The target object pointer to store.
     /// @param[in] func The target member function to store.
     /// @param[in] thread The execution thread to invoke `func`.
-    DelegateMemberAsync(SharedPtr object, MemberFunc func, DelegateThread& thread) : BaseType(object, func), m_thread(&thread) {
+    DelegateMemberAsync(SharedPtr object, MemberFunc func, DelegateThread& thread) : BaseType(object, func) {
         Bind(object, func, thread);
     }
 
@@ -344,7 +505,7 @@ public:
     /// @param[in] object The target object pointer to store.
     /// @param[in] func The target const member function to store.
     /// @param[in] thread The execution thread to invoke `func`.
-    DelegateMemberAsync(SharedPtr object, ConstMemberFunc func, DelegateThread& thread) : BaseType(object, func), m_thread(&thread) {
+    DelegateMemberAsync(SharedPtr object, ConstMemberFunc func, DelegateThread& thread) : BaseType(object, func) {
         Bind(object, func, thread);
     }
 
@@ -352,7 +513,7 @@ public:
     /// @param[in] object The target object pointer to store.
     /// @param[in] func The target member function to store.
     /// @param[in] thread The execution thread to invoke `func`.
-    DelegateMemberAsync(ObjectPtr object, MemberFunc func, DelegateThread& thread) : BaseType(object, func), m_thread(&thread) {
+    DelegateMemberAsync(ObjectPtr object, MemberFunc func, DelegateThread& thread) : BaseType(object, func) {
         Bind(object, func, thread);
     }
 
@@ -360,7 +521,7 @@ public:
     /// @param[in] object The target object pointer to store.
     /// @param[in] func The target const member function to store.
     /// @param[in] thread The execution thread to invoke `func`.
-    DelegateMemberAsync(ObjectPtr object, ConstMemberFunc func, DelegateThread& thread) : BaseType(object, func), m_thread(&thread) {
+    DelegateMemberAsync(ObjectPtr object, ConstMemberFunc func, DelegateThread& thread) : BaseType(object, func) {
         Bind(object, func, thread);
     }
 
@@ -370,14 +531,15 @@ public:
     /// set the state of the new instance.
     /// @param[in] rhs The object to copy from.
     DelegateMemberAsync(const ClassType& rhs) :
-        BaseType(rhs), m_thread(rhs.m_thread) {
+        BaseType(rhs) {
         Assign(rhs);
     }
 
     /// @brief Move constructor that transfers ownership of resources.
     /// @param[in] rhs The object to move from.
     DelegateMemberAsync(ClassType&& rhs) noexcept :
-        BaseType(rhs), m_thread(rhs.m_thread) {
+        BaseType(rhs) {
+        m_thread = rhs.m_thread;
         rhs.Clear();
     }
 
@@ -545,29 +707,9 @@ public:
             if (!delegate)
                 BAD_ALLOC();
 
-            // Create a new message instance for sending to the destination thread
-            auto msg = std::make_shared<DelegateAsyncMsg<Args...>>(delegate, std::forward<Args>(args)...);
-            if (!msg)
-                BAD_ALLOC();
-
-            auto thread = this->GetThread();
-            if (thread) {
-                // Dispatch message onto the callback destination thread. Invoke()
-                // will be called by the destintation thread. 
-                thread->DispatchDelegate(msg);
-            }
-
-            // Do not wait for destination thread return value from async function call
-            return RetType();
-
-            // Check if any argument is a shared_ptr with wrong usage
-            // std::shared_ptr reference arguments are not allowed with asynchronous delegates as the behavior is 
-            // undefined. In other words:
-            // void MyFunc(std::shared_ptr<T> data)		// Ok!
-            // void MyFunc(std::shared_ptr<T>& data)	// Error if DelegateAsync or DelegateSpAsync target!
-            static_assert(!(std::disjunction_v<is_shared_ptr<Args>...> &&
-                (std::disjunction_v<std::is_lvalue_reference<Args>, std::is_pointer<Args>> || ...)),
-                "std::shared_ptr reference argument not allowed");
+            // Dispatch a message with argument copies onto the destination thread. 
+            // Do not wait for destination thread return value from async function call.
+            return this->DispatchAsync(delegate, std::forward<Args>(args)...);
         }
     }
 
@@ -578,40 +720,18 @@ public:
         operator()(std::forward<Args>(args)...);
     }
 
-    /// @brief Invoke the delegate function on the destination thread. Called by the 
-    /// destintation thread.
-    /// @details Each source thread call to `operator()` generate a call to `Invoke()` 
-    /// on the destination thread. Unlike `DelegateAsyncWait`, a lock is not required between 
-    /// source and destination `delegateMsg` access because the source thread is not waiting 
-    /// for the function call to complete.
-    /// @param[in] msg The delegate message created and sent within `operator()(Args... args)`.
-    /// @return `true` if target function invoked; `false` if error. 
-    virtual bool Invoke(std::shared_ptr<DelegateMsg> msg) override {
-        // Typecast the base pointer to back correct derived to instance
-        auto delegateMsg = std::dynamic_pointer_cast<DelegateAsyncMsg<Args...>>(msg);
-        if (delegateMsg == nullptr)
-            return false;
-
-        // Invoke the delegate function synchronously
-        m_sync = true;
+protected:
+    using DelegateAsyncCore::m_thread;
+    using DelegateAsyncCore::m_sync;
 
-        // Invoke the target function using the source thread supplied function arguments
-        std::apply(&BaseType::operator(), 
-            std::tuple_cat(std::make_tuple(this), delegateMsg->GetArgs()));
-        return true;
+    /// @brief Invoke the bound target function synchronously. Called by `Invoke()` 
+    /// on the destination thread.
+    /// @param[in] args The function arguments, if any.
+    /// @return The bound function return value, if any.
+    virtual RetType SyncInvoke(Args... args) override {
+        return BaseType::operator()(std::forward<Args>(args)...);
     }
 
-    ///@brief Get the destination thread that the target function is invoked on.
-    // @return The target thread.
-    DelegateThread* GetThread() noexcept { return m_thread; }
-
-private:
-    /// The target thread to invoke the delegate function.
-    DelegateThread* m_thread = nullptr;   
-
-    /// Flag to control synchronous vs asynchronous target invoke behavior.
-    bool m_sync = false;        
-
     // </common_code>
 };
 
@@ -628,7 +748,7 @@ struct DelegateFunctionAsync; // Not defined
 /// @tparam RetType The return type of the bound delegate function.
 /// @tparam Args The argument types of the bound delegate function.
 template <class RetType, class... Args>
-class DelegateFunctionAsync<RetType(Args...)> : public DelegateFunction<RetType(Args...)>, public IDelegateInvoker {
+class DelegateFunctionAsync<RetType(Args...)> : public DelegateFunction<RetType(Args...)>, public DelegateAsyncBase<RetType(Args...)> {
 public:
     using FunctionType = std::function<RetType(Args...)>;
     using ClassType = DelegateFunctionAsync<RetType(Args...)>;
@@ -638,7 +758,7 @@ public:
     /// @param[in] func The target `std::function` to store.
     /// @param[in] thread The execution thread to invoke `func`.
     DelegateFunctionAsync(FunctionType func, DelegateThread& thread) :
-        BaseType(func), m_thread(&thread) {
+        BaseType(func) {
         Bind(func, thread);
     }
 
@@ -648,14 +768,15 @@ public:
     /// set the state of the new instance.
     /// @param[in] rhs The object to copy from.
     DelegateFunctionAsync(const ClassType& rhs) :
-        BaseType(rhs), m_thread(rhs.m_thread) {
+        BaseType(rhs) {
         Assign(rhs);
     }
 
     /// @brief Move constructor that transfers ownership of resources.
     /// @param[in] rhs The object to move from.
     DelegateFunctionAsync(ClassType&& rhs) noexcept :
-        BaseType(rhs), m_thread(rhs.m_thread) {
+        BaseType(rhs) {
+        m_thread = rhs.m_thread;
         rhs.Clear();
     }
 
@@ -786,29 +907,9 @@ public:
             if (!delegate)
                 BAD_ALLOC();
 
-            // Create a new message instance for sending to the destination thread
-            auto msg = std::make_shared<DelegateAsyncMsg<Args...>>(delegate, std::forward<Args>(args)...);
-            if (!msg)
-                BAD_ALLOC();
-
-            auto thread = this->GetThread();
-            if (thread) {
-                // Dispatch message onto the callback destination thread. Invoke()
-                // will be called by the destintation thread. 
-                thread->DispatchDelegate(msg);
-            }
-
-            // Do not wait for destination thread return value from async function call
-            return RetType();
-
-            // Check if any argument is a shared_ptr with wrong usage
-            // std::shared_ptr reference arguments are not allowed with asynchronous delegates as the behavior is 
-            // undefined. In other words:
-            // void MyFunc(std::shared_ptr<T> data)		// Ok!
-            // void MyFunc(std::shared_ptr<T>& data)	// Error if DelegateAsync or DelegateSpAsync target!
-            static_assert(!(std::disjunction_v<is_shared_ptr<Args>...> &&
-                (std::disjunction_v<std::is_lvalue_reference<Args>, std::is_pointer<Args>> || ...)),
-                "std::shared_ptr reference argument not allowed");
+            // Dispatch a message with argument copies onto the destination thread. 
+            // Do not wait for destination thread return value from async function call.
+            return this->DispatchAsync(delegate, std::forward<Args>(args)...);
         }
     }
 
@@ -819,40 +920,18 @@ public:
         operator()(std::forward<Args>(args)...);
     }
 
-    /// @brief Invoke the delegate function on the destination thread. Called by the 
-    /// destintation thread.
-    /// @details Each source thread call to `operator()` generate a call to `Invoke()` 
-    /// on the destination thread. Unlike `DelegateAsyncWait`, a lock is not required between 
-    /// source and destination `delegateMsg` access because the source thread is not waiting 
-    /// for the function call to complete.
-    /// @param[in] msg The delegate message created and sent within `operator()(Args... args)`.
-    /// @return `true` if target function invoked; `false` if error. 
-    virtual bool Invoke(std::shared_ptr<DelegateMsg> msg) override {
-        // Typecast the base pointer to back correct derived to instance
-        auto delegateMsg = std::dynamic_pointer_cast<DelegateAsyncMsg<Args...>>(msg);
-        if (delegateMsg == nullptr)
-            return false;
-
-        // Invoke the delegate function synchronously
-        m_sync = true;
+protected:
+    using DelegateAsyncCore::m_thread;
+    using DelegateAsyncCore::m_sync;
 
-        // Invoke the target function using the source thread supplied function arguments
-        std::apply(&BaseType::operator(), 
-            std::tuple_cat(std::make_tuple(this), delegateMsg->GetArgs()));
-        return true;
+    /// @brief Invoke the bound target function synchronously. Called by `Invoke()` 
+    /// on the destination thread.
+    /// @param[in] args The function arguments, if any.
+    /// @return The bound function return value, if any.
+    virtual RetType SyncInvoke(Args... args) override {
+        return BaseType::operator()(std::forward<Args>(args)...);
     }
 
-    ///@brief Get the destination thread that the target function is invoked on.
-    // @return The target thread.
-    DelegateThread* GetThread() noexcept { return m_thread; }
-
-private:
-    /// The target thread to invoke the delegate function.
-    DelegateThread* m_thread = nullptr;   
-
-    /// Flag to control synchronous vs asynchronous target invoke behavior.
-    bool m_sync = false;        
-
     // </common_code>
 };
 
@@ -44,7 +44,12 @@
 /// * `std::function` compares the function signature type, not the underlying object instance.
 /// See `DelegateFunction<>` class for more info.
 ///
-/// Code within `<common_code>` and `</common_code>` is updated using sync_src.py. Manually update 
+/// The message, destination thread invoke and return value code lives in `DelegateAsyncWaitBase<>`, 
+/// which is instantiated once per function signature and shared by the free, member and 
+/// `std::function` classes. Signature independent state and the blocking dispatch live in the 
+/// non-template `DelegateAsyncWaitCore`, and the semaphore and lock in `DelegateAsyncWaitMsgBase`.
+/// 
+/// Code within `<common_code>` and `</common_code>` is updated using src_dup.py. Manually update 
 /// the code within the `DelegateFreeAsyncWait` `common_code` tags, then run the script to 
 /// propagate to the remaining delegate classes to simplify code maintenance.
 /// 
@@ -62,24 +67,19 @@ namespace DelegateLib {
 #undef max  // Prevent compiler error on next line if max is defined
 constexpr auto WAIT_INFINITE = std::chrono::milliseconds::max();
 
-/// @brief Stores all function arguments suitable for blocking asynchronous calls.
-/// Argument data is not stored in the heap.
-/// @tparam Args The target function arguments.
-template <class...Args>
-class DelegateAsyncWaitMsg : public DelegateMsg
+/// @brief Source and destination thread synchronization data for blocking 
+/// asynchronous calls. Independent of the target function signature.
+class DelegateAsyncWaitMsgBase : public DelegateMsg
 {
 public:
     /// Constructor
     /// @param[in] invoker - the invoker instance
-    /// @param[in] args - a parameter pack of all target function arguments
-    DelegateAsyncWaitMsg(std::shared_ptr<IDelegateInvoker> invoker, Args... args) : DelegateMsg(invoker),
-        m_args(std::forward<Args>(args)...) {}
+    DelegateAsyncWaitMsgBase(std::shared_ptr<IDelegateInvoker> invoker) : DelegateMsg(invoker) {}
 
-    virtual ~DelegateAsyncWaitMsg() {}
+    virtual ~DelegateAsyncWaitMsgBase() {}
 
-    /// Get all function arguments 
-    /// @return A tuple of all function arguments
-    std::tuple<Args...>& GetArgs() { return m_args; }
+    /// The source thread waits on the message, so it is never discarded.
+    virtual bool IsSheddable() const override { return false; }
 
     /// Get the semaphore used to signal the sending thread that the receiving 
     /// thread has invoked the target function. 
@@ -102,12 +102,6 @@ public:
     void SetInvokerWaiting(bool invokerWaiting) { m_invokerWaiting = invokerWaiting; }
 
 private:
-    /// An empty starting tuple
-    std::tuple<> m_start;
-
-    /// A tuple with each function argument element 
-    std::tuple<Args...> m_args;
-
     /// Semaphore to signal waiting thread
     Semaphore m_sema;
 
@@ -118,6 +112,227 @@ private:
     bool m_invokerWaiting = false;          
 };
 
+/// @brief Stores all function arguments suitable for blocking asynchronous calls.
+/// Argument data is not stored in the heap.
+/// @tparam Args The target function arguments.
+template <class...Args>
+class DelegateAsyncWaitMsg : public DelegateAsyncWaitMsgBase
+{
+public:
+    /// Constructor
+    /// @param[in] invoker - the invoker instance
+    /// @param[in] args - a parameter pack of all target function arguments
+    DelegateAsyncWaitMsg(std::shared_ptr<IDelegateInvoker> invoker, Args... args) : DelegateAsyncWaitMsgBase(invoker),
+        m_args(std::forward<Args>(args)...) { SetSize(sizeof(DelegateAsyncWaitMsg)); }
+
+    virtual ~DelegateAsyncWaitMsg() {}
+
+    /// Get all function arguments 
+    /// @return A tuple of all function arguments
+    std::tuple<Args...>& GetArgs() { return m_args; }
+
+private:
+    /// A tuple with each function argument element 
+    std::tuple<Args...> m_args;
+};
+
+/// @brief Non-template state and dispatch code shared by all `AsyncWait` delegates 
+/// regardless of function signature.
+class DelegateAsyncWaitCore
+{
+public:
+    /// Returns `true` if asynchronous function successfully invoked on the target thread
+    /// @return `true` if the target asynchronous function call succeeded. `false` if 
+    /// the timeout expired before the target function could be invoked.
+    bool IsSuccess() noexcept { return m_success; }
+
+    ///@brief Get the destination thread that the target function is invoked on.
+    // @return The target thread.
+    DelegateThread* GetThread() noexcept { return m_thread; }
+
+protected:
+    /// @brief Dispatch a message onto the destination thread and block until the 
+    /// target function is invoked or `m_timeout` expires. Called by the source thread.
+    /// @param[in] msg The delegate message to dispatch.
+    /// @param[in] invoker The delegate clone that invokes the target function and 
+    /// stores the return value on the destination thread.
+    void DispatchAndWait(std::shared_ptr<DelegateAsyncWaitMsgBase> msg, const DelegateAsyncWaitCore& invoker) {
+        DispatchNoWait(msg);
+
+        // Wait for destination thread to execute the delegate function and get return value
+        if (Complete(msg, m_timeout))
+            m_retVal = invoker.m_retVal;
+    }
+
+    /// @brief Dispatch a message onto the destination thread without blocking.
+    /// `Complete()` must be called afterwards. Called by the source thread.
+    /// @param[in] msg The delegate message to dispatch.
+    void DispatchNoWait(std::shared_ptr<DelegateAsyncWaitMsgBase> msg) {
+        msg->SetInvokerWaiting(true);
+
+        // Dispatch message onto the callback destination thread. Invoke()
+        // will be called by the destination thread. 
+        if (m_thread)
+            m_thread->DispatchDelegate(msg);
+    }
+
+    /// @brief Block until the target function of a dispatched message is invoked or
+    /// the timeout expires. Afterwards the target function is not invoked. Called by
+    /// the source thread.
+    /// @param[in] msg The delegate message passed to `DispatchNoWait()`.
+    /// @param[in] timeout The time to wait.
+    /// @return `true` if the target function was invoked.
+    bool Complete(std::shared_ptr<DelegateAsyncWaitMsgBase> msg, std::chrono::milliseconds timeout) {
+        m_success = m_thread && msg->GetSema().Wait(timeout);
+
+        // Protect data shared between source and destination threads
+        const std::lock_guard<std::mutex> lock(msg->GetLock());
+
+        // Set flag that source is not waiting anymore
+        msg->SetInvokerWaiting(false);
+        return m_success;
+    }
+
+    /// The target thread to invoke the delegate function.
+    DelegateThread* m_thread = nullptr;
+
+    /// Flag to control synchronous vs asynchronous target invoke behavior.
+    bool m_sync = false;
+
+    /// Set to `true` if async function call succeeds
+    bool m_success = false;			        
+
+    /// Time in mS to wait for async function to invoke
+    std::chrono::milliseconds m_timeout = WAIT_INFINITE;    
+
+    /// Return value of the target invoked function
+    std::any m_retVal;                      
+
+    friend class DelegateGather;
+};
+
+template <class R>
+struct DelegateAsyncWaitBase; // Not defined
+
+/// @brief Blocking asynchronous invoke machinery shared by all `AsyncWait` delegates 
+/// with the same function signature. 
+/// @details `DelegateFreeAsyncWait`, `DelegateMemberAsyncWait` and `DelegateFunctionAsyncWait` 
+/// are thin shims over this class, so the message and destination thread invoke code 
+/// is instantiated once per function signature rather than once per delegate class.
+/// @tparam RetType The return type of the bound delegate function.
+/// @tparam Args The argument types of the bound delegate function.
+template <class RetType, class... Args>
+class DelegateAsyncWaitBase<RetType(Args...)> : public IDelegateInvoker, public DelegateAsyncWaitCore 
+{
+public:
+    /// @brief Invoke the delegate function on the destination thread. Called by the 
+    /// destination thread.
+    /// @details Each source thread call to `operator()` generate a call to `Invoke()` 
+    /// on the destination thread. A lock is used to protect source and destination thread shared 
+    /// data. A semaphore is used to signal the source thread when the destination thread 
+    /// completes the target function call.
+    /// 
+    /// If source thread timeout expires and before the destination thread invokes the 
+    /// target function, the target function is not called.
+    /// @param[in] msg The delegate message created and sent within `operator()(Args... args)`.
+    /// @return `true` if target function invoked or timeout expired; `false` if error. 
+    virtual bool Invoke(std::shared_ptr<DelegateMsg> msg) override {
+        static_assert(!(is_unique_ptr<RetType>::value), "std::unique_ptr return value not allowed");
+
+        // Typecast the base pointer to back correct derived to instance
+        auto delegateMsg = std::dynamic_pointer_cast<DelegateAsyncWaitMsg<Args...>>(msg);
+        if (delegateMsg == nullptr)
+            return false;
+
+        // Protect data shared between source and destination threads
+        const std::lock_guard<std::mutex> lock(delegateMsg->GetLock());
+
+        // Is the source thread waiting for the target function invoke to complete?
+        if (delegateMsg->GetInvokerWaiting()) {
+            // Invoke the delegate function synchronously
+            m_sync = true;
+
+            // Does target function have a void return value?
+            if constexpr (std::is_void<RetType>::value == true) {
+                // Invoke the target function using the source thread supplied function arguments
+                std::apply(&DelegateAsyncWaitBase::SyncInvoke, std::tuple_cat(std::make_tuple(this), delegateMsg->GetArgs()));
+            } else {
+                // Invoke the target function using the source thread supplied function arguments 
+                // and get the return value
+                m_retVal = std::apply(&DelegateAsyncWaitBase::SyncInvoke, std::tuple_cat(std::make_tuple(this), delegateMsg->GetArgs()));
+            }
+
+            // Signal the source thread that the destination thread function call is complete
+            delegateMsg->GetSema().Signal();
+        }
+        return true;
+    }
+
+    /// Get the asynchronous function return value
+    /// @return The destination thraed target function return value
+    RetType GetRetVal() noexcept {
+        try {
+            return std::any_cast<RetType>(m_retVal);
+        }
+        catch (const std::bad_any_cast&) {
+            return RetType{};  // Return a default value if error
+        }
+    }
+
+protected:
+    /// @brief Dispatch the function arguments to the destination thread and block 
+    /// for the return value. Called by the source thread.
+    /// @param[in] invoker The delegate clone that invokes the target on the destination thread.
+    /// @param[in] args The function arguments, if any.
+    /// @return The bound function return value, if any. Use `IsSuccess()` to determine if 
+    /// the return value is valid before use.
+    /// @throws std::bad_alloc If dynamic memory allocation fails and USE_ASSERTS not defined.
+    RetType DispatchWait(std::shared_ptr<DelegateAsyncWaitBase> invoker, Args... args) {
+        // Create a new message instance for sending to the destination thread.
+        auto msg = std::make_shared<DelegateAsyncWaitMsg<Args...>>(invoker, std::forward<Args>(args)...);
+        if (!msg)
+            BAD_ALLOC();
+
+        DispatchAndWait(msg, *invoker);
+
+        // Does the target function have a return value?
+        if constexpr (std::is_void<RetType>::value == false) {
+            // Is the return value valid? 
+            if (m_retVal.has_value()) {
+                // Return the destination thread target function return value
+                return GetRetVal();
+            } else {
+                // Return a default return value
+                return RetType{};
+            }
+        }
+    }
+
+    /// @brief Dispatch the function arguments to the destination thread without
+    /// blocking. Used by `DelegateGather`.
+    /// @param[in] invoker The delegate clone that invokes the target on the destination 
+    /// thread and stores the return value.
+    /// @param[in] args The function arguments, if any.
+    /// @return The dispatched message to pass to `Complete()`.
+    /// @throws std::bad_alloc If dynamic memory allocation fails and USE_ASSERTS not defined.
+    std::shared_ptr<DelegateAsyncWaitMsgBase> Scatter(std::shared_ptr<DelegateAsyncWaitBase> invoker, Args... args) {
+        auto msg = std::make_shared<DelegateAsyncWaitMsg<Args...>>(invoker, std::forward<Args>(args)...);
+        if (!msg)
+            BAD_ALLOC();
+
+        DispatchNoWait(msg);
+        return msg;
+    }
+
+    /// @brief Invoke the bound target function synchronously. Implemented by each 
+    /// delegate class to call its synchronous base class.
+    /// @param[in] args The function arguments, if any.
+    /// @return The bound function return value, if any.
+    virtual RetType SyncInvoke(Args... args) = 0;
+
+    friend class DelegateGather;
+};
+
 template <class R>
 struct DelegateFreeAsyncWait; // Not defined
 
@@ -125,7 +340,7 @@ struct DelegateFreeAsyncWait; // Not defined
 /// @tparam RetType The return type of the bound delegate function.
 /// @tparam Args The argument types of the bound delegate function.
 template <class RetType, class... Args>
-class DelegateFreeAsyncWait<RetType(Args...)> : public DelegateFree<RetType(Args...)>, public IDelegateInvoker {
+class DelegateFreeAsyncWait<RetType(Args...)> : public DelegateFree<RetType(Args...)>, public DelegateAsyncWaitBase<RetType(Args...)> {
 public:
     typedef RetType(*FreeFunc)(Args...);
     using ClassType = DelegateFreeAsyncWait<RetType(Args...)>;
@@ -137,8 +352,8 @@ public:
     /// @param[in] timeout The calling thread timeout for destination thread to
     /// invoke the target function. 
     DelegateFreeAsyncWait(FreeFunc func, DelegateThread& thread, std::chrono::milliseconds timeout = WAIT_INFINITE) :
-        BaseType(func), m_thread(&thread), m_timeout(timeout) {
-        Bind(func, thread);
+        BaseType(func) {
+        Bind(func, thread, timeout);
     }
 
     /// @brief Copy constructor that creates a copy of the given instance.
@@ -154,7 +369,11 @@ public:
     /// @brief Move constructor that transfers ownership of resources.
     /// @param[in] rhs The object to move from.
     DelegateFreeAsyncWait(ClassType&& rhs) noexcept :
-        BaseType(rhs), m_thread(rhs.m_thread), m_timeout(rhs.m_timeout), m_success(rhs.m_success), m_retVal(rhs.m_retVal) {
+        BaseType(rhs) {
+        m_thread = rhs.m_thread;
+        m_timeout = rhs.m_timeout;
+        m_success = rhs.m_success;
+        m_retVal = rhs.m_retVal;
         rhs.Clear();
     }
 
@@ -302,40 +521,8 @@ public:
             if (!delegate)
                 BAD_ALLOC();
 
-            // Create a new message instance for sending to the destination thread.
-            auto msg = std::make_shared<DelegateAsyncWaitMsg<Args...>>(delegate, std::forward<Args>(args)...);
-            if (!msg)
-                BAD_ALLOC();
-            msg->SetInvokerWaiting(true);
-
-            auto thread = this->GetThread();
-            if (thread) {
-                // Dispatch message onto the callback destination thread. Invoke()
-                // will be called by the destination thread. 
-                thread->DispatchDelegate(msg);
-
-                // Wait for destination thread to execute the delegate function and get return value
-                if ((m_success = msg->GetSema().Wait(m_timeout)))
-                    m_retVal = delegate->m_retVal;
-            }
-
-            // Protect data shared between source and destination threads
-            const std::lock_guard<std::mutex> lock(msg->GetLock());
-
-            // Set flag that source is not waiting anymore
-            msg->SetInvokerWaiting(false);
-
-            // Does the target function have a return value?
-            if constexpr (std::is_void<RetType>::value == false) {
-                // Is the return value valid? 
-                if (m_retVal.has_value()) {
-                    // Return the destination thread target function return value
-                    return GetRetVal();
-                } else {
-                    // Return a default return value
-                    return RetType{};
-                }
-            }
+            // Dispatch a message onto the destination thread and wait for the return value
+            return this->DispatchWait(delegate, std::forward<Args>(args)...);
         }
     }
 
@@ -348,92 +535,28 @@ public:
     auto AsyncInvoke(Args... args) {
         if constexpr (std::is_void<RetType>::value == true) {
             operator()(args...);
-            return IsSuccess() ? std::optional<bool>(true) : std::optional<bool>();
+            return this->IsSuccess() ? std::optional<bool>(true) : std::optional<bool>();
         } else {
             auto retVal = operator()(args...);
-            return IsSuccess() ? std::optional<RetType>(retVal) : std::optional<RetType>();
+            return this->IsSuccess() ? std::optional<RetType>(retVal) : std::optional<RetType>();
         }
     }
 
-    /// @brief Invoke the delegate function on the destination thread. Called by the 
-    /// destination thread.
-    /// @details Each source thread call to `operator()` generate a call to `Invoke()` 
-    /// on the destination thread. A lock is used to protect source and destination thread shared 
-    /// data. A semaphore is used to signal the source thread when the destination thread 
-    /// completes the target function call.
-    /// 
-    /// If source thread timeout expires and before the destination thread invokes the 
-    /// target function, the target function is not called.
-    /// @param[in] msg The delegate message created and sent within `operator()(Args... args)`.
-    /// @return `true` if target function invoked or timeout expired; `false` if error. 
-    virtual bool Invoke(std::shared_ptr<DelegateMsg> msg) override {
-        static_assert(!(is_unique_ptr<RetType>::value), "std::unique_ptr return value not allowed");
-
-        // Typecast the base pointer to back correct derived to instance
-        auto delegateMsg = std::dynamic_pointer_cast<DelegateAsyncWaitMsg<Args...>>(msg);
-        if (delegateMsg == nullptr)
-            return false;
-
-        // Protect data shared between source and destination threads
-        const std::lock_guard<std::mutex> lock(delegateMsg->GetLock());
-
-        // Is the source thread waiting for the target function invoke to complete?
-        if (delegateMsg->GetInvokerWaiting()) {
-            // Invoke the delegate function synchronously
-            m_sync = true;
-
-            // Does target function have a void return value?
-            if constexpr (std::is_void<RetType>::value == true) {
-                // Invoke the target function using the source thread supplied function arguments
-                std::apply(&BaseType::operator(), std::tuple_cat(std::make_tuple(this), delegateMsg->GetArgs()));
-            } else {
-                // Invoke the target function using the source thread supplied function arguments 
-                // and get the return value
-                m_retVal = std::apply(&BaseType::operator(), std::tuple_cat(std::make_tuple(this), delegateMsg->GetArgs()));
-            }
-
-            // Signal the source thread that the destination thread function call is complete
-            delegateMsg->GetSema().Signal();
-        }
-        return true;
-    }
-
-    /// Returns `true` if asynchronous function successfully invoked on the target thread
-    /// @return `true` if the target asynchronous function call succeeded. `false` if 
-    /// the timeout expired before the target function could be invoked.
-    bool IsSuccess() noexcept { return m_success; }
+protected:
+    using DelegateAsyncWaitCore::m_thread;
+    using DelegateAsyncWaitCore::m_sync;
+    using DelegateAsyncWaitCore::m_success;
+    using DelegateAsyncWaitCore::m_timeout;
+    using DelegateAsyncWaitCore::m_retVal;
 
-    /// Get the asynchronous function return value
-    /// @return The destination thraed target function return value
-    RetType GetRetVal() noexcept {
-        try {
-            return std::any_cast<RetType>(m_retVal);
-        }
-        catch (const std::bad_any_cast&) {
-            return RetType{};  // Return a default value if error
-        }
+    /// @brief Invoke the bound target function synchronously. Called by `Invoke()` 
+    /// on the destination thread.
+    /// @param[in] args The function arguments, if any.
+    /// @return The bound function return value, if any.
+    virtual RetType SyncInvoke(Args... args) override {
+        return BaseType::operator()(std::forward<Args>(args)...);
     }
 
-    ///@brief Get the destination thread that the target function is invoked on.
-    // @return The target thread.
-    DelegateThread* GetThread() noexcept { return m_thread; }
-
-private:
-    /// The target thread to invoke the delegate function.
-    DelegateThread* m_thread = nullptr;
-
-    /// Flag to control synchronous vs asynchronous target invoke behavior.
-    bool m_sync = false;
-
-    /// Set to `true` if async function call succeeds
-    bool m_success = false;			        
-
-    /// Time in mS to wait for async function to invoke
-    std::chrono::milliseconds m_timeout = WAIT_INFINITE;    
-
-    /// Return value of the target invoked function
-    std::any m_retVal;                      
-
     // </common_code>
 };
 
@@ -445,7 +568,7 @@ struct DelegateMemberAsyncWait; // Not defined
 /// @tparam RetType The return type of the bound delegate function.
 /// @tparam Args The argument types of the bound delegate function.
 template <class TClass, class RetType, class... Args>
-class DelegateMemberAsyncWait<TClass, RetType(Args...)> : public DelegateMember<TClass, RetType(Args...)>, public IDelegateInvoker {
+class DelegateMemberAsyncWait<TClass, RetType(Args...)> : public DelegateMember<TClass, RetType(Args...)>, public DelegateAsyncWaitBase<RetType(Args...)> {
 public:
     typedef TClass* ObjectPtr;
     typedef std::shared_ptr<TClass> SharedPtr;
@@ -461,8 +584,8 @@ public:
     /// @param[in] timeout The calling thread timeout for destination thread to
     /// invoke the target function. 
     DelegateMemberAsyncWait(SharedPtr object, MemberFunc func, DelegateThread& thread, std::chrono::milliseconds timeout = WAIT_INFINITE) :
-        BaseType(object, func), m_thread(&thread), m_timeout(timeout) {
-        Bind(object, func, thread);
+        BaseType(object, func) {
+        Bind(object, func, thread, timeout);
     }
 
     /// @brief Constructor to create a class instance.
@@ -472,8 +595,8 @@ public:
     /// @param[in] timeout The calling thread timeout for destination thread to
     /// invoke the target function. 
     DelegateMemberAsyncWait(SharedPtr object, ConstMemberFunc func, DelegateThread& thread, std::chrono::milliseconds timeout) :
-        BaseType(object, func), m_thread(&thread), m_timeout(timeout) {
-        Bind(object, func, thread);
+        BaseType(object, func) {
+        Bind(object, func, thread, timeout);
     }
 
     /// @brief Constructor to create a class instance.
@@ -483,8 +606,8 @@ public:
     /// @param[in] timeout The calling thread timeout for destination thread to
     /// invoke the target function. 
     DelegateMemberAsyncWait(ObjectPtr object, MemberFunc func, DelegateThread& thread, std::chrono::milliseconds timeout = WAIT_INFINITE) :
-        BaseType(object, func), m_thread(&thread), m_timeout(timeout) {
-        Bind(object, func, thread);
+        BaseType(object, func) {
+        Bind(object, func, thread, timeout);
     }
 
     /// @brief Constructor to create a class instance.
@@ -494,8 +617,8 @@ public:
     /// @param[in] timeout The calling thread timeout for destination thread to
     /// invoke the target function. 
     DelegateMemberAsyncWait(ObjectPtr object, ConstMemberFunc func, DelegateThread& thread, std::chrono::milliseconds timeout) :
-        BaseType(object, func), m_thread(&thread), m_timeout(timeout) {
-        Bind(object, func, thread);
+        BaseType(object, func) {
+        Bind(object, func, thread, timeout);
     }
 
     /// @brief Copy constructor that creates a copy of the given instance.
@@ -511,7 +634,11 @@ public:
     /// @brief Move constructor that transfers ownership of resources.
     /// @param[in] rhs The object to move from.
     DelegateMemberAsyncWait(ClassType&& rhs) noexcept :
-        BaseType(rhs), m_thread(rhs.m_thread), m_timeout(rhs.m_timeout), m_success(rhs.m_success), m_retVal(rhs.m_retVal) {
+        BaseType(rhs) {
+        m_thread = rhs.m_thread;
+        m_timeout = rhs.m_timeout;
+        m_success = rhs.m_success;
+        m_retVal = rhs.m_retVal;
         rhs.Clear();
     }
 
@@ -705,40 +832,8 @@ public:
             if (!delegate)
                 BAD_ALLOC();
 
-            // Create a new message instance for sending to the destination thread.
-            auto msg = std::make_shared<DelegateAsyncWaitMsg<Args...>>(delegate, std::forward<Args>(args)...);
-            if (!msg)
-                BAD_ALLOC();
-            msg->SetInvokerWaiting(true);
-
-            auto thread = this->GetThread();
-            if (thread) {
-                // Dispatch message onto the callback destination thread. Invoke()
-                // will be called by the destination thread. 
-                thread->DispatchDelegate(msg);
-
-                // Wait for destination thread to execute the delegate function and get return value
-                if ((m_success = msg->GetSema().Wait(m_timeout)))
-                    m_retVal = delegate->m_retVal;
-            }
-
-            // Protect data shared between source and destination threads
-            const std::lock_guard<std::mutex> lock(msg->GetLock());
-
-            // Set flag that source is not waiting anymore
-            msg->SetInvokerWaiting(false);
-
-            // Does the target function have a return value?
-            if constexpr (std::is_void<RetType>::value == false) {
-                // Is the return value valid? 
-                if (m_retVal.has_value()) {
-                    // Return the destination thread target function return value
-                    return GetRetVal();
-                } else {
-                    // Return a default return value
-                    return RetType{};
-                }
-            }
+            // Dispatch a message onto the destination thread and wait for the return value
+            return this->DispatchWait(delegate, std::forward<Args>(args)...);
         }
     }
 
@@ -751,92 +846,28 @@ public:
     auto AsyncInvoke(Args... args) {
         if constexpr (std::is_void<RetType>::value == true) {
             operator()(args...);
-            return IsSuccess() ? std::optional<bool>(true) : std::optional<bool>();
+            return this->IsSuccess() ? std::optional<bool>(true) : std::optional<bool>();
         } else {
             auto retVal = operator()(args...);
-            return IsSuccess() ? std::optional<RetType>(retVal) : std::optional<RetType>();
-        }
-    }
-
-    /// @brief Invoke the delegate function on the destination thread. Called by the 
-    /// destination thread.
-    /// @details Each source thread call to `operator()` generate a call to `Invoke()` 
-    /// on the destination thread. A lock is used to protect source and destination thread shared 
-    /// data. A semaphore is used to signal the source thread when the destination thread 
-    /// completes the target function call.
-    /// 
-    /// If source thread timeout expires and before the destination thread invokes the 
-    /// target function, the target function is not called.
-    /// @param[in] msg The delegate message created and sent within `operator()(Args... args)`.
-    /// @return `true` if target function invoked or timeout expired; `false` if error. 
-    virtual bool Invoke(std::shared_ptr<DelegateMsg> msg) override {
-        static_assert(!(is_unique_ptr<RetType>::value), "std::unique_ptr return value not allowed");
-
-        // Typecast the base pointer to back correct derived to instance
-        auto delegateMsg = std::dynamic_pointer_cast<DelegateAsyncWaitMsg<Args...>>(msg);
-        if (delegateMsg == nullptr)
-            return false;
-
-        // Protect data shared between source and destination threads
-        const std::lock_guard<std::mutex> lock(delegateMsg->GetLock());
-
-        // Is the source thread waiting for the target function invoke to complete?
-        if (delegateMsg->GetInvokerWaiting()) {
-            // Invoke the delegate function synchronously
-            m_sync = true;
-
-            // Does target function have a void return value?
-            if constexpr (std::is_void<RetType>::value == true) {
-                // Invoke the target function using the source thread supplied function arguments
-                std::apply(&BaseType::operator(), std::tuple_cat(std::make_tuple(this), delegateMsg->GetArgs()));
-            } else {
-                // Invoke the target function using the source thread supplied function arguments 
-                // and get the return value
-                m_retVal = std::apply(&BaseType::operator(), std::tuple_cat(std::make_tuple(this), delegateMsg->GetArgs()));
-            }
-
-            // Signal the source thread that the destination thread function call is complete
-            delegateMsg->GetSema().Signal();
+            return this->IsSuccess() ? std::optional<RetType>(retVal) : std::optional<RetType>();
         }
-        return true;
     }
 
-    /// Returns `true` if asynchronous function successfully invoked on the target thread
-    /// @return `true` if the target asynchronous function call succeeded. `false` if 
-    /// the timeout expired before the target function could be invoked.
-    bool IsSuccess() noexcept { return m_success; }
+protected:
+    using DelegateAsyncWaitCore::m_thread;
+    using DelegateAsyncWaitCore::m_sync;
+    using DelegateAsyncWaitCore::m_success;
+    using DelegateAsyncWaitCore::m_timeout;
+    using DelegateAsyncWaitCore::m_retVal;
 
-    /// Get the asynchronous function return value
-    /// @return The destination thraed target function return value
-    RetType GetRetVal() noexcept {
-        try {
-            return std::any_cast<RetType>(m_retVal);
-        }
-        catch (const std::bad_any_cast&) {
-            return RetType{};  // Return a default value if error
-        }
+    /// @brief Invoke the bound target function synchronously. Called by `Invoke()` 
+    /// on the destination thread.
+    /// @param[in] args The function arguments, if any.
+    /// @return The bound function return value, if any.
+    virtual RetType SyncInvoke(Args... args) override {
+        return BaseType::operator()(std::forward<Args>(args)...);
     }
 
-    ///@brief Get the destination thread that the target function is invoked on.
-    // @return The target thread.
-    DelegateThread* GetThread() noexcept { return m_thread; }
-
-private:
-    /// The target thread to invoke the delegate function.
-    DelegateThread* m_thread = nullptr;
-
-    /// Flag to control synchronous vs asynchronous target invoke behavior.
-    bool m_sync = false;
-
-    /// Set to `true` if async function call succeeds
-    bool m_success = false;			        
-
-    /// Time in mS to wait for async function to invoke
-    std::chrono::milliseconds m_timeout = WAIT_INFINITE;    
-
-    /// Return value of the target invoked function
-    std::any m_retVal;                      
-
     // </common_code>
 };
 
@@ -850,7 +881,7 @@ struct DelegateFunctionAsyncWait; // Not defined
 /// @tparam RetType The return type of the bound delegate function.
 /// @tparam Args The argument types of the bound delegate function.
 template <class RetType, class... Args>
-class DelegateFunctionAsyncWait<RetType(Args...)> : public DelegateFunction<RetType(Args...)>, public IDelegateInvoker {
+class DelegateFunctionAsyncWait<RetType(Args...)> : public DelegateFunction<RetType(Args...)>, public DelegateAsyncWaitBase<RetType(Args...)> {
 public:
     using FunctionType = std::function<RetType(Args...)>;
     using ClassType = DelegateFunctionAsyncWait<RetType(Args...)>;
@@ -862,8 +893,8 @@ public:
     /// @param[in] timeout The calling thread timeout for destination thread to
     /// invoke the target function. 
     DelegateFunctionAsyncWait(FunctionType func, DelegateThread& thread, std::chrono::milliseconds timeout = WAIT_INFINITE) :
-        BaseType(func), m_thread(&thread), m_timeout(timeout) {
-        Bind(func, thread);
+        BaseType(func) {
+        Bind(func, thread, timeout);
     }
 
     /// @brief Copy constructor that creates a copy of the given instance.
@@ -879,7 +910,11 @@ public:
     /// @brief Move constructor that transfers ownership of resources.
     /// @param[in] rhs The object to move from.
     DelegateFunctionAsyncWait(ClassType&& rhs) noexcept :
-        BaseType(rhs), m_thread(rhs.m_thread), m_timeout(rhs.m_timeout), m_success(rhs.m_success), m_retVal(rhs.m_retVal) {
+        BaseType(rhs) {
+        m_thread = rhs.m_thread;
+        m_timeout = rhs.m_timeout;
+        m_success = rhs.m_success;
+        m_retVal = rhs.m_retVal;
         rhs.Clear();
     }
 
@@ -1027,40 +1062,8 @@ public:
             if (!delegate)
                 BAD_ALLOC();
 
-            // Create a new message instance for sending to the destination thread.
-            auto msg = std::make_shared<DelegateAsyncWaitMsg<Args...>>(delegate, std::forward<Args>(args)...);
-            if (!msg)
-                BAD_ALLOC();
-            msg->SetInvokerWaiting(true);
-
-            auto thread = this->GetThread();
-            if (thread) {
-                // Dispatch message onto the callback destination thread. Invoke()
-                // will be called by the destination thread. 
-                thread->DispatchDelegate(msg);
-
-                // Wait for destination thread to execute the delegate function and get return value
-                if ((m_success = msg->GetSema().Wait(m_timeout)))
-                    m_retVal = delegate->m_retVal;
-            }
-
-            // Protect data shared between source and destination threads
-            const std::lock_guard<std::mutex> lock(msg->GetLock());
-
-            // Set flag that source is not waiting anymore
-            msg->SetInvokerWaiting(false);
-
-            // Does the target function have a return value?
-            if constexpr (std::is_void<RetType>::value == false) {
-                // Is the return value valid? 
-                if (m_retVal.has_value()) {
-                    // Return the destination thread target function return value
-                    return GetRetVal();
-                } else {
-                    // Return a default return value
-                    return RetType{};
-                }
-            }
+            // Dispatch a message onto the destination thread and wait for the return value
+            return this->DispatchWait(delegate, std::forward<Args>(args)...);
         }
     }
 
@@ -1073,92 +1076,28 @@ public:
     auto AsyncInvoke(Args... args) {
         if constexpr (std::is_void<RetType>::value == true) {
             operator()(args...);
-            return IsSuccess() ? std::optional<bool>(true) : std::optional<bool>();
+            return this->IsSuccess() ? std::optional<bool>(true) : std::optional<bool>();
         } else {
             auto retVal = operator()(args...);
-            return IsSuccess() ? std::optional<RetType>(retVal) : std::optional<RetType>();
-        }
-    }
-
-    /// @brief Invoke the delegate function on the destination thread. Called by the 
-    /// destination thread.
-    /// @details Each source thread call to `operator()` generate a call to `Invoke()` 
-    /// on the destination thread. A lock is used to protect source and destination thread shared 
-    /// data. A semaphore is used to signal the source thread when the destination thread 
-    /// completes the target function call.
-    /// 
-    /// If source thread timeout expires and before the destination thread invokes the 
-    /// target function, the target function is not called.
-    /// @param[in] msg The delegate message created and sent within `operator()(Args... args)`.
-    /// @return `true` if target function invoked or timeout expired; `false` if error. 
-    virtual bool Invoke(std::shared_ptr<DelegateMsg> msg) override {
-        static_assert(!(is_unique_ptr<RetType>::value), "std::unique_ptr return value not allowed");
-
-        // Typecast the base pointer to back correct derived to instance
-        auto delegateMsg = std::dynamic_pointer_cast<DelegateAsyncWaitMsg<Args...>>(msg);
-        if (delegateMsg == nullptr)
-            return false;
-
-        // Protect data shared between source and destination threads
-        const std::lock_guard<std::mutex> lock(delegateMsg->GetLock());
-
-        // Is the source thread waiting for the target function invoke to complete?
-        if (delegateMsg->GetInvokerWaiting()) {
-            // Invoke the delegate function synchronously
-            m_sync = true;
-
-            // Does target function have a void return value?
-            if constexpr (std::is_void<RetType>::value == true) {
-                // Invoke the target function using the source thread supplied function arguments
-                std::apply(&BaseType::operator(), std::tuple_cat(std::make_tuple(this), delegateMsg->GetArgs()));
-            } else {
-                // Invoke the target function using the source thread supplied function arguments 
-                // and get the return value
-                m_retVal = std::apply(&BaseType::operator(), std::tuple_cat(std::make_tuple(this), delegateMsg->GetArgs()));
-            }
-
-            // Signal the source thread that the destination thread function call is complete
-            delegateMsg->GetSema().Signal();
+            return this->IsSuccess() ? std::optional<RetType>(retVal) : std::optional<RetType>();
         }
-        return true;
     }
 
-    /// Returns `true` if asynchronous function successfully invoked on the target thread
-    /// @return `true` if the target asynchronous function call succeeded. `false` if 
-    /// the timeout expired before the target function could be invoked.
-    bool IsSuccess() noexcept { return m_success; }
+protected:
+    using DelegateAsyncWaitCore::m_thread;
+    using DelegateAsyncWaitCore::m_sync;
+    using DelegateAsyncWaitCore::m_success;
+    using DelegateAsyncWaitCore::m_timeout;
+    using DelegateAsyncWaitCore::m_retVal;
 
-    /// Get the asynchronous function return value
-    /// @return The destination thraed target function return value
-    RetType GetRetVal() noexcept {
-        try {
-            return std::any_cast<RetType>(m_retVal);
-        }
-        catch (const std::bad_any_cast&) {
-            return RetType{};  // Return a default value if error
-        }
+    /// @brief Invoke the bound target function synchronously. Called by `Invoke()` 
+    /// on the destination thread.
+    /// @param[in] args The function arguments, if any.
+    /// @return The bound function return value, if any.
+    virtual RetType SyncInvoke(Args... args) override {
+        return BaseType::operator()(std::forward<Args>(args)...);
     }
 
-    ///@brief Get the destination thread that the target function is invoked on.
-    // @return The target thread.
-    DelegateThread* GetThread() noexcept { return m_thread; }
-
-private:
-    /// The target thread to invoke the delegate function.
-    DelegateThread* m_thread = nullptr;
-
-    /// Flag to control synchronous vs asynchronous target invoke behavior.
-    bool m_sync = false;
-
-    /// Set to `true` if async function call succeeds
-    bool m_success = false;			        
-
-    /// Time in mS to wait for async function to invoke
-    std::chrono::milliseconds m_timeout = WAIT_INFINITE;    
-
-    /// Return value of the target invoked function
-    std::any m_retVal;                      
-
     // </common_code>
 };
 
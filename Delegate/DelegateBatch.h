@@ -0,0 +1,318 @@
+#ifndef _DELEGATE_BATCH_H
+#define _DELEGATE_BATCH_H
+
+/// @file
+/// @brief Asynchronous delegate that batches invocations into one message.
+///
+/// @details High rate producers invoking the same asynchronous target pay one
+/// message allocation, queue push and potential wakeup per call. A
+/// `DelegateBatch<>` instead appends a copy of the arguments to an open batch
+/// on the source side, and posts one message per batch. The destination thread
+/// closes the batch when it dequeues the message, then invokes the target once
+/// per element in a tight loop.
+///
+/// Batching is self-clocking in the style of Nagle's algorithm. The first call
+/// after a batch closes opens a new batch and posts its message immediately, so
+/// an idle destination is never delayed. While the message waits in the queue,
+/// further calls join the same batch at no queue cost. A batch is also closed
+/// when it holds `maxCount` elements, bounding the message size; the next call
+/// opens and posts another batch. Batches are posted in the order they are
+/// opened, so calls from one source thread are invoked in order.
+///
+/// Arguments are copied by value. Pointer arguments are not supported since the
+/// target cannot know how long the pointed to data remains valid. Only `void`
+/// target functions are supported.
+
+#include "Delegate.h"
+#include "DelegateThread.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace DelegateLib {
+
+template <class R>
+class DelegateBatch; // Not defined
+
+/// @brief `DelegateBatch<>` class asynchronously invokes a target delegate on a
+/// destination thread with invocations batched into shared messages.
+/// @details Copies of a `DelegateBatch` share one batching channel, so a copy
+/// stored within a multicast delegate container batches together with the
+/// original. Thread-safe.
+/// @tparam Args The argument types of the bound delegate function.
+template <class... Args>
+class DelegateBatch<void(Args...)> : public Delegate<void(Args...)> {
+    static_assert(!std::disjunction_v<std::is_pointer<std::decay_t<Args>>...>,
+        "DelegateBatch does not support pointer arguments");
+
+public:
+    using DelegateType = Delegate<void(Args...)>;
+    using ClassType = DelegateBatch<void(Args...)>;
+
+    /// @brief Constructor to create a class instance.
+    /// @param[in] delegate The synchronous target delegate invoked on the
+    /// destination thread. A clone is stored.
+    /// @param[in] thread The destination thread.
+    /// @param[in] maxCount The maximum number of invocations within one message.
+    DelegateBatch(const DelegateType& delegate, DelegateThread& thread, std::size_t maxCount = 64) {
+        Bind(delegate, thread, maxCount);
+    }
+
+    /// @brief Copy constructor. The copy shares the batching channel.
+    /// @param[in] rhs The object to copy from.
+    DelegateBatch(const ClassType& rhs) { Assign(rhs); }
+
+    /// @brief Move constructor that transfers ownership of resources.
+    /// @param[in] rhs The object to move from.
+    DelegateBatch(ClassType&& rhs) noexcept : m_channel(std::move(rhs.m_channel)) { }
+
+    /// @brief Default constructor creates an empty delegate.
+    DelegateBatch() = default;
+
+    /// @brief Bind a target delegate and destination thread.
+    /// @param[in] delegate The synchronous target delegate. A clone is stored.
+    /// @param[in] thread The destination thread.
+    /// @param[in] maxCount The maximum number of invocations within one message.
+    void Bind(const DelegateType& delegate, DelegateThread& thread, std::size_t maxCount = 64) {
+        auto delegateClone = delegate.Clone();
+        if (!delegateClone)
+            BAD_ALLOC();
+
+        try {
+            m_channel = std::make_shared<Channel>(std::unique_ptr<DelegateType>(delegateClone),
+                thread, maxCount > 0 ? maxCount : 1);
+        }
+        catch (const std::bad_alloc&) {
+            BAD_ALLOC();
+        }
+    }
+
+    /// @brief Creates a copy of the current object sharing the batching channel.
+    /// @return A pointer to a new `ClassType` instance.
+    /// @post The caller is responsible for deleting the clone object.
+    virtual ClassType* Clone() const override {
+        return new(std::nothrow) ClassType(*this);
+    }
+
+    /// @brief Assigns the state of one object to another.
+    /// @param[in] rhs The object whose state is to be copied.
+    void Assign(const ClassType& rhs) {
+        m_channel = rhs.m_channel;
+    }
+
+    /// @brief Append a copy of the arguments to the open batch. Called by the
+    /// source thread.
+    /// @param[in] args The function arguments, if any.
+    /// @throws std::bad_alloc If dynamic memory allocation fails and USE_ASSERTS not defined.
+    virtual void operator()(Args... args) override {
+        if (m_channel)
+            m_channel->Append(m_channel, args...);
+    }
+
+    /// @brief Assignment operator that assigns the state of one object to another.
+    /// @param[in] rhs The object whose state is to be assigned to the current object.
+    /// @return A reference to the current object.
+    ClassType& operator=(const ClassType& rhs) {
+        if (&rhs != this) {
+            Assign(rhs);
+        }
+        return *this;
+    }
+
+    /// @brief Move assignment operator that transfers ownership of resources.
+    /// @param[in] rhs The object to move from.
+    /// @return A reference to the current object.
+    ClassType& operator=(ClassType&& rhs) noexcept {
+        if (&rhs != this) {
+            m_channel = std::move(rhs.m_channel);
+        }
+        return *this;
+    }
+
+    /// @brief Clear the target function.
+    virtual void operator=(std::nullptr_t) noexcept {
+        return Clear();
+    }
+
+    /// @brief Compares two delegate objects for equality.
+    /// @param[in] rhs The `DelegateBase` object to compare with the current object.
+    /// @return `true` if both have equal target delegates and destination threads.
+    virtual bool Equal(const DelegateBase& rhs) const override {
+        auto derivedRhs = dynamic_cast<const ClassType*>(&rhs);
+        if (derivedRhs) {
+            if (Empty() || derivedRhs->Empty())
+                return Empty() && derivedRhs->Empty();
+            return m_channel->thread == derivedRhs->m_channel->thread &&
+                m_channel->target->Equal(*derivedRhs->m_channel->target);
+        }
+        return false;
+    }
+
+    /// Compares two delegate objects for equality.
+    /// @return `true` if the objects are equal, `false` otherwise.
+    bool operator==(const ClassType& rhs) const noexcept { return Equal(rhs); }
+
+    /// Overload operator== to compare the delegate to nullptr
+    /// @return `true` if delegate is null.
+    virtual bool operator==(std::nullptr_t) const noexcept override {
+        return Empty();
+    }
+
+    /// Overload operator!= to compare the delegate to nullptr
+    /// @return `true` if delegate is not null.
+    virtual bool operator!=(std::nullptr_t) const noexcept override {
+        return !Empty();
+    }
+
+    /// Overload operator== to compare the delegate to nullptr
+    /// @return `true` if delegate is null.
+    friend bool operator==(std::nullptr_t, const ClassType& rhs) noexcept {
+        return rhs.Empty();
+    }
+
+    /// Overload operator!= to compare the delegate to nullptr
+    /// @return `true` if delegate is not null.
+    friend bool operator!=(std::nullptr_t, const ClassType& rhs) noexcept {
+        return !rhs.Empty();
+    }
+
+    /// @brief Check if the delegate is bound to a target function.
+    /// @return `true` if the delegate has a target function, `false` otherwise.
+    bool Empty() const noexcept { return !m_channel; }
+
+    /// @brief Clear the target function. Batches already posted are still delivered.
+    /// @post The delegate is empty.
+    void Clear() noexcept { m_channel = nullptr; }
+
+    /// @brief Implicit conversion operator to `bool`.
+    /// @return `true` if the object is not empty, `false` if the object is empty.
+    explicit operator bool() const noexcept { return !Empty(); }
+
+    ///@brief Get the destination thread that the target function is invoked on.
+    // @return The target thread.
+    DelegateThread* GetThread() const noexcept { return m_channel ? m_channel->thread : nullptr; }
+
+    /// @brief Get the number of batch messages posted to the destination thread.
+    std::size_t GetMessageCount() const noexcept { return m_channel ? m_channel->messages.load() : 0; }
+
+private:
+    /// Argument copies of one invocation.
+    using ArgsTuple = std::tuple<std::decay_t<Args>...>;
+
+    /// Invocations delivered by one message.
+    struct Batch {
+        std::vector<ArgsTuple> calls;
+        bool closed = false;
+    };
+
+    /// Message posted to the destination thread for one batch.
+    class BatchMsg : public DelegateMsg {
+    public:
+        BatchMsg(std::shared_ptr<IDelegateInvoker> invoker, std::shared_ptr<Batch> batch) :
+            DelegateMsg(invoker), m_batch(batch) { 
+            SetSize(sizeof(BatchMsg) + sizeof(Batch) + batch->calls.capacity() * sizeof(ArgsTuple));
+        }
+
+        std::shared_ptr<Batch> GetBatch() const { return m_batch; }
+
+        /// Close the discarded batch so later calls open a new one rather than
+        /// joining a batch that is never delivered.
+        virtual void OnDiscarded() override {
+            auto channel = std::static_pointer_cast<Channel>(GetDelegateInvoker());
+            if (channel)
+                channel->Close(m_batch);
+        }
+
+    private:
+        std::shared_ptr<Batch> m_batch;
+    };
+
+    /// Batching state shared by all copies of a delegate. Invokes each batch on
+    /// the destination thread.
+    struct Channel : public IDelegateInvoker {
+        Channel(std::unique_ptr<DelegateType> target, DelegateThread& thread, std::size_t maxCount) :
+            target(std::move(target)), thread(&thread), maxCount(maxCount) { }
+
+        /// Append to the open batch, opening and posting a new batch if required.
+        /// Called by the source thread.
+        void Append(const std::shared_ptr<Channel>& self, const std::remove_reference_t<Args>&... args) {
+            // Hold the post lock until a new batch is posted so batches reach the
+            // destination in the order they were opened
+            const std::lock_guard<std::mutex> postLock(postMutex);
+            std::shared_ptr<Batch> posted;
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                if (!open || open->closed || open->calls.size() >= maxCount) {
+                    open = std::make_shared<Batch>();
+                    open->calls.reserve(maxCount);
+                    posted = open;
+                    messages++;
+                }
+                open->calls.emplace_back(args...);
+            }
+
+            // Post outside the batch lock; the destination thread, or a discarded
+            // message on this thread, takes it to close the batch
+            if (posted) {
+                auto msg = std::make_shared<BatchMsg>(self, posted);
+                if (!msg)
+                    BAD_ALLOC();
+                thread->DispatchDelegate(msg);
+            }
+        }
+
+        /// Close the batch and invoke the target once per element. Called by the
+        /// destination thread.
+        virtual bool Invoke(std::shared_ptr<DelegateMsg> msg) override {
+            auto batchMsg = std::dynamic_pointer_cast<BatchMsg>(msg);
+            if (batchMsg == nullptr)
+                return false;
+
+            std::shared_ptr<Batch> batch = batchMsg->GetBatch();
+            Close(batch);
+
+            for (ArgsTuple& call : batch->calls)
+                std::apply(*target, call);
+            return true;
+        }
+
+        /// Close a batch to further calls. Called when the batch is delivered or
+        /// its message discarded.
+        void Close(const std::shared_ptr<Batch>& batch) {
+            const std::lock_guard<std::mutex> lock(mutex);
+            batch->closed = true;
+            if (open == batch)
+                open = nullptr;
+        }
+
+        std::unique_ptr<DelegateType> target;
+        DelegateThread* thread;
+        std::size_t maxCount;
+        std::atomic<std::size_t> messages{ 0 };
+
+        std::mutex postMutex;
+        std::mutex mutex;
+        std::shared_ptr<Batch> open;
+    };
+
+    /// The batching channel shared by copies of this delegate.
+    std::shared_ptr<Channel> m_channel;
+};
+
+/// @brief Creates a delegate that batches asynchronous invocations of a target.
+/// @tparam Args The types of the function arguments.
+/// @param[in] delegate The synchronous target delegate invoked on the destination thread.
+/// @param[in] thread The destination thread.
+/// @param[in] maxCount The maximum number of invocations within one message.
+/// @return A `DelegateBatch` object.
+template <class... Args>
+auto MakeDelegateBatch(const Delegate<void(Args...)>& delegate, DelegateThread& thread, std::size_t maxCount = 64) {
+    return DelegateBatch<void(Args...)>(delegate, thread, maxCount);
+}
+
+}
+
+#endif
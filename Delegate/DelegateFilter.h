@@ -0,0 +1,212 @@
+#ifndef _DELEGATE_FILTER_H
+#define _DELEGATE_FILTER_H
+
+/// @file
+/// @brief Delegate wrapper invoking a target delegate only when a predicate
+/// accepts the arguments.
+///
+/// @details Insert a `DelegateFilter<>` into a multicast delegate container to
+/// subscribe to a fraction of the broadcasts. The predicate is evaluated on the
+/// invoking (publishing) thread before the target delegate is called, so an
+/// asynchronous target never clones itself, copies the arguments or queues a
+/// message for a rejected broadcast. The predicate receives the arguments by
+/// const reference and must be thread-safe with respect to the publisher.
+
+#include "Delegate.h"
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+namespace DelegateLib {
+
+template <class R>
+class DelegateFilter; // Not defined
+
+/// @brief `DelegateFilter<>` class invokes a target delegate if the predicate
+/// returns `true` for the invocation arguments.
+/// @tparam RetType The return type of the bound delegate function.
+/// @tparam Args The argument types of the bound delegate function.
+template <class RetType, class... Args>
+class DelegateFilter<RetType(Args...)> : public Delegate<RetType(Args...)> {
+public:
+    using DelegateType = Delegate<RetType(Args...)>;
+    using PredicateType = std::function<bool(const std::remove_reference_t<Args>&...)>;
+    using ClassType = DelegateFilter<RetType(Args...)>;
+
+    /// @brief Constructor to create a class instance.
+    /// @param[in] delegate The target delegate invoked when the predicate accepts.
+    /// @param[in] predicate The predicate evaluated on the invoking thread.
+    DelegateFilter(const DelegateType& delegate, PredicateType predicate) { Bind(delegate, predicate); }
+
+    /// @brief Copy constructor that creates a copy of the given instance.
+    /// @param[in] rhs The object to copy from.
+    DelegateFilter(const ClassType& rhs) { Assign(rhs); }
+
+    /// @brief Move constructor that transfers ownership of resources.
+    /// @param[in] rhs The object to move from.
+    DelegateFilter(ClassType&& rhs) noexcept :
+        m_delegate(std::move(rhs.m_delegate)), m_predicate(std::move(rhs.m_predicate)) { }
+
+    /// @brief Default constructor creates an empty delegate.
+    DelegateFilter() = default;
+
+    /// @brief Destructor ensures empty when destroyed.
+    ~DelegateFilter() { Clear(); }
+
+    /// @brief Bind a target delegate and predicate.
+    /// @param[in] delegate The target delegate. A clone is stored.
+    /// @param[in] predicate The predicate evaluated on the invoking thread.
+    void Bind(const DelegateType& delegate, PredicateType predicate) {
+        auto delegateClone = delegate.Clone();
+        if (!delegateClone)
+            BAD_ALLOC();
+
+        try {
+            m_delegate = std::shared_ptr<DelegateType>(delegateClone);
+            m_predicate = predicate;
+        }
+        catch (const std::bad_alloc&) {
+            BAD_ALLOC();
+        }
+    }
+
+    /// @brief Creates a copy of the current object.
+    /// @details The target delegate is shared with the copy; a target delegate
+    /// is not modified after binding.
+    /// @return A pointer to a new `ClassType` instance.
+    /// @post The caller is responsible for deleting the clone object.
+    virtual ClassType* Clone() const override {
+        return new(std::nothrow) ClassType(*this);
+    }
+
+    /// @brief Assigns the state of one object to another.
+    /// @param[in] rhs The object whose state is to be copied.
+    void Assign(const ClassType& rhs) {
+        m_delegate = rhs.m_delegate;
+        m_predicate = rhs.m_predicate;
+    }
+
+    /// @brief Invoke the target delegate if the predicate accepts the arguments.
+    /// @param[in] args - the function arguments, if any.
+    /// @return The target delegate return value, if invoked. Otherwise the
+    /// default return type is returned.
+    virtual RetType operator()(Args... args) override {
+        if (Empty())
+            return RetType();
+        if (m_predicate && !m_predicate(args...))
+            return RetType();
+        return (*m_delegate)(std::forward<Args>(args)...);
+    }
+
+    /// @brief Assignment operator that assigns the state of one object to another.
+    /// @param[in] rhs The object whose state is to be assigned to the current object.
+    /// @return A reference to the current object.
+    ClassType& operator=(const ClassType& rhs) {
+        if (&rhs != this) {
+            Assign(rhs);
+        }
+        return *this;
+    }
+
+    /// @brief Move assignment operator that transfers ownership of resources.
+    /// @param[in] rhs The object to move from.
+    /// @return A reference to the current object.
+    ClassType& operator=(ClassType&& rhs) noexcept {
+        if (&rhs != this) {
+            m_delegate = std::move(rhs.m_delegate);
+            m_predicate = std::move(rhs.m_predicate);
+        }
+        return *this;
+    }
+
+    /// @brief Clear the target delegate and predicate.
+    virtual void operator=(std::nullptr_t) noexcept {
+        return Clear();
+    }
+
+    /// @brief Compares two delegate objects for equality.
+    /// @details A filter equals another filter with an equal target delegate, or
+    /// equals its own target delegate. This allows a multicast container to remove
+    /// a filtered subscription using the unfiltered target delegate.
+    /// @param[in] rhs The `DelegateBase` object to compare with the current object.
+    /// @return `true` if the two delegate objects are equal, `false` otherwise.
+    virtual bool Equal(const DelegateBase& rhs) const override {
+        auto derivedRhs = dynamic_cast<const ClassType*>(&rhs);
+        if (derivedRhs) {
+            if (Empty() || derivedRhs->Empty())
+                return Empty() && derivedRhs->Empty();
+            return m_delegate->Equal(*derivedRhs->m_delegate);
+        }
+
+        if (Empty())
+            return false;
+        return m_delegate->Equal(rhs);
+    }
+
+    /// Compares two delegate objects for equality.
+    /// @return `true` if the objects are equal, `false` otherwise.
+    bool operator==(const ClassType& rhs) const noexcept { return Equal(rhs); }
+
+    /// Overload operator== to compare the delegate to nullptr
+    /// @return `true` if delegate is null.
+    virtual bool operator==(std::nullptr_t) const noexcept override {
+        return Empty();
+    }
+
+    /// Overload operator!= to compare the delegate to nullptr
+    /// @return `true` if delegate is not null.
+    virtual bool operator!=(std::nullptr_t) const noexcept override {
+        return !Empty();
+    }
+
+    /// Overload operator== to compare the delegate to nullptr
+    /// @return `true` if delegate is null.
+    friend bool operator==(std::nullptr_t, const ClassType& rhs) noexcept {
+        return rhs.Empty();
+    }
+
+    /// Overload operator!= to compare the delegate to nullptr
+    /// @return `true` if delegate is not null.
+    friend bool operator!=(std::nullptr_t, const ClassType& rhs) noexcept {
+        return !rhs.Empty();
+    }
+
+    /// @brief Check if the delegate is bound to a target delegate.
+    /// @return `true` if the delegate has a target delegate, `false` otherwise.
+    bool Empty() const noexcept { return !m_delegate || *m_delegate == nullptr; }
+
+    /// @brief Clear the target delegate and predicate.
+    /// @post The delegate is empty.
+    void Clear() noexcept {
+        m_delegate = nullptr;
+        m_predicate = nullptr;
+    }
+
+    /// @brief Implicit conversion operator to `bool`.
+    /// @return `true` if the object is not empty, `false` if the object is empty.
+    explicit operator bool() const noexcept { return !Empty(); }
+
+private:
+    /// The target delegate, shared between copies of this filter.
+    std::shared_ptr<DelegateType> m_delegate;
+
+    /// The predicate evaluated before invoking the target delegate.
+    PredicateType m_predicate;
+};
+
+/// @brief Creates a delegate that invokes a target delegate only when the
+/// predicate returns `true` for the arguments.
+/// @tparam RetType The return type of the target delegate.
+/// @tparam Args The types of the function arguments.
+/// @tparam Predicate A callable `bool(const Args&...)`.
+/// @param[in] delegate The target delegate, synchronous or asynchronous.
+/// @param[in] predicate The predicate evaluated on the invoking thread.
+/// @return A `DelegateFilter` object wrapping a copy of the target delegate.
+template <class RetType, class... Args, class Predicate>
+auto MakeDelegateFilter(const Delegate<RetType(Args...)>& delegate, Predicate predicate) {
+    return DelegateFilter<RetType(Args...)>(delegate, predicate);
+}
+
+}
+
+#endif
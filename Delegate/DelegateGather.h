@@ -0,0 +1,108 @@
+#ifndef _DELEGATE_GATHER_H
+#define _DELEGATE_GATHER_H
+
+/// @file
+/// @brief Scatter-gather of blocking asynchronous calls across threads.
+///
+/// @details Calling N `AsyncWait` delegates one after another blocks for the sum
+/// of their round trips. A `DelegateGather` dispatches every call immediately
+/// and then waits for all of them against one deadline, so the caller blocks
+/// for the slowest round trip only.
+///
+///    DelegateGather gather;
+///    auto speed = gather.Add(MakeDelegate(&centrifuge, &Centrifuge::GetSpeed, centrifugeThread, WAIT_INFINITE));
+///    auto pressure = gather.Add(MakeDelegate(&sensor, &Sensor::Read, sensorThread, WAIT_INFINITE), channel);
+///    gather.Wait(std::chrono::milliseconds(50));
+///    if (speed->IsSuccess())
+///        int rpm = speed->GetRetVal();
+///
+/// `Add()` returns the clone of the delegate that invokes the target on the
+/// destination thread. After `Wait()` returns, use its `IsSuccess()` and
+/// `GetRetVal()` for the per call result. The timeout of the delegate passed to
+/// `Add()` is ignored; `Wait()` applies one timeout to every call. A target not
+/// invoked before the deadline is not invoked later, as with `AsyncWait`.
+///
+/// As with `AsyncWait`, arguments are not copied. Every argument passed to
+/// `Add()`, including outgoing reference arguments, must remain valid until
+/// `Wait()` returns. Not thread-safe; use from the source thread only.
+
+#include "DelegateAsyncWait.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace DelegateLib {
+
+/// @brief Dispatches blocking asynchronous calls to their destination threads
+/// at once and waits for all of them with a single timeout.
+class DelegateGather
+{
+public:
+    DelegateGather() = default;
+    DelegateGather(const DelegateGather&) = delete;
+    DelegateGather& operator=(const DelegateGather&) = delete;
+
+    /// Destructor. Waits for any calls not yet waited for.
+    ~DelegateGather() { Wait(WAIT_INFINITE); }
+
+    /// Dispatch a call to the delegate's destination thread without blocking.
+    /// @param[in] delegate An `AsyncWait` delegate, e.g. `DelegateMemberAsyncWait<>`.
+    /// @param[in] args The function arguments, if any.
+    /// @return The delegate clone holding the call result once `Wait()` returns.
+    /// @throws std::bad_alloc If dynamic memory allocation fails and USE_ASSERTS not defined.
+    template <class DelegateType, class... Args>
+    std::shared_ptr<DelegateType> Add(const DelegateType& delegate, Args&&... args) {
+        auto invoker = std::shared_ptr<DelegateType>(delegate.Clone());
+        if (!invoker)
+            BAD_ALLOC();
+
+        Call call;
+        call.invoker = invoker;
+        if (!invoker->Empty())
+            call.msg = invoker->Scatter(invoker, std::forward<Args>(args)...);
+        m_calls.push_back(call);
+        return invoker;
+    }
+
+    /// Wait until every call added since the last `Wait()` has been invoked, or
+    /// the timeout expires.
+    /// @param[in] timeout The time to wait for all calls combined.
+    /// @return `true` if every call succeeded.
+    bool Wait(std::chrono::milliseconds timeout) {
+        auto deadline = std::chrono::steady_clock::now();
+        if (timeout != WAIT_INFINITE)
+            deadline += timeout;
+
+        bool success = true;
+        for (Call& call : m_calls) {
+            std::chrono::milliseconds remaining = WAIT_INFINITE;
+            if (timeout != WAIT_INFINITE) {
+                auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+                remaining = left.count() > 0 ? left : std::chrono::milliseconds(0);
+            }
+
+            if (call.msg)
+                success &= call.invoker->Complete(call.msg, remaining);
+            else
+                success = call.invoker->m_success = false;
+        }
+        m_calls.clear();
+        return success;
+    }
+
+    /// Get the number of calls not yet waited for.
+    std::size_t Size() const { return m_calls.size(); }
+
+private:
+    /// A dispatched call
+    struct Call {
+        std::shared_ptr<DelegateAsyncWaitCore> invoker;
+        std::shared_ptr<DelegateAsyncWaitMsgBase> msg;
+    };
+
+    std::vector<Call> m_calls;
+};
+
+}
+
+#endif
@@ -58,7 +58,12 @@
 #include "DelegateOpt.h"
 #include "MulticastDelegateSafe.h"
 #include "UnicastDelegate.h"
+#include "DelegateFilter.h"
+#include "TopicRouter.h"
 #include "DelegateAsync.h"
 #include "DelegateAsyncWait.h"
+#include "DelegateGather.h"
+#include "DelegateBatch.h"
+#include "DelegateSerialize.h"
 
 #endif
@@ -34,10 +34,34 @@ public:
 	/// @return The invoker instance. 
 	std::shared_ptr<IDelegateInvoker> GetDelegateInvoker() const { return m_invoker; }
 
+	/// Get the approximate bytes held by the message, including argument copies. 
+	/// Memory allocated by an argument type itself, such as a string buffer, is 
+	/// not included.
+	/// @return The message size in bytes.
+	std::size_t GetSize() const { return m_size; }
+
+	/// Check if a destination thread over its memory budget may discard the 
+	/// message. Messages a source thread waits on are never discarded.
+	/// @return `true` if the message may be discarded.
+	virtual bool IsSheddable() const { return true; }
+
+	/// Called on the source thread when the destination thread discards the 
+	/// message instead of queuing it, e.g. to shed load over its memory budget. 
+	/// The message is never invoked.
+	virtual void OnDiscarded() { }
+
+protected:
+	/// Set the message size. Called by derived class constructors.
+	/// @param[in] size - the message size in bytes.
+	void SetSize(std::size_t size) { m_size = size; }
+
 private:
 	/// The IDelegateInvoker instance used to invoke the target function 
     /// on the destination thread of control
 	std::shared_ptr<IDelegateInvoker> m_invoker;
+
+	/// The approximate bytes held by the message
+	std::size_t m_size = sizeof(DelegateMsg);
 };
 
 }
@@ -0,0 +1,145 @@
+#ifndef _DELEGATE_PARALLEL_H
+#define _DELEGATE_PARALLEL_H
+
+/// @file
+/// @brief Fork-join execution of synchronous delegate targets across threads.
+///
+/// @details A `ParallelJob<>` runs a list of targets with the same arguments.
+/// The caller posts one runner message to each helper `DelegateThread`, then
+/// runs targets itself. Each runner, including the caller, claims the next
+/// unstarted target until none remain, so a busy or slow helper only delays
+/// the targets it has already claimed. The caller returns when every target
+/// has finished.
+///
+/// The arguments are not copied. Every target receives references to the
+/// caller's arguments, which stay valid since the caller waits. Concurrent
+/// targets must not modify a shared argument. A runner dequeued after the job
+/// finished finds no target to claim and does not touch the arguments.
+
+#include "Delegate.h"
+#include "DelegateThread.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace DelegateLib {
+
+template <class R>
+class ParallelJob; // Not defined
+
+/// @brief One parallel invocation of a list of synchronous targets.
+/// @tparam RetType The return type of the target functions.
+/// @tparam Args The argument types of the target functions.
+template <class RetType, class... Args>
+class ParallelJob<RetType(Args...)> : public IDelegateInvoker
+{
+public:
+    using DelegateType = Delegate<RetType(Args...)>;
+    using ResultType = std::conditional_t<std::is_void_v<RetType>, int, std::decay_t<RetType>>;
+
+    /// Constructor
+    /// @param[in] targets The targets to invoke. Must remain valid until Run() returns.
+    /// @param[in] gather `true` to store each target's return value.
+    /// @param[in] args The arguments used when invoking the targets.
+    ParallelJob(std::vector<DelegateType*>&& targets, bool gather, std::add_lvalue_reference_t<Args>... args) :
+        m_targets(std::move(targets)), m_args(args...) {
+        if (gather && !m_targets.empty()) {
+            m_results.reset(new(std::nothrow) ResultType[m_targets.size()]);
+            if (!m_results)
+                BAD_ALLOC();
+        }
+    }
+
+    /// Invoke every target using the caller and helper threads, then wait for
+    /// all targets to finish. Called by the caller thread only.
+    /// @param[in] self The shared pointer owning this job.
+    /// @param[in] threads The helper threads.
+    /// @param[in] maxConcurrency The maximum number of targets running at once,
+    /// including the caller. 0 for no limit.
+    static void Run(const std::shared_ptr<ParallelJob>& self, const std::vector<DelegateThread*>& threads,
+        std::size_t maxConcurrency) {
+        std::size_t count = self->m_targets.size();
+        if (count == 0)
+            return;
+
+        // The caller is one runner; post the rest to helper threads
+        std::size_t runners = count;
+        if (maxConcurrency > 0 && maxConcurrency < runners)
+            runners = maxConcurrency;
+        if (threads.size() + 1 < runners)
+            runners = threads.size() + 1;
+
+        for (std::size_t i = 0; i + 1 < runners; i++) {
+            auto msg = std::make_shared<DelegateMsg>(self);
+            if (!msg)
+                BAD_ALLOC();
+            threads[i]->DispatchDelegate(msg);
+        }
+
+        self->Claim();
+
+        std::unique_lock<std::mutex> lock(self->m_lock);
+        self->m_cv.wait(lock, [&self, count] { return self->m_finished == count; });
+    }
+
+    /// Claim and invoke targets. Called by a helper thread.
+    virtual bool Invoke(std::shared_ptr<DelegateMsg>) override {
+        Claim();
+        return true;
+    }
+
+    /// Move the return values out in target order. Valid after Run() if gathering.
+    std::vector<ResultType> TakeResults() {
+        std::vector<ResultType> results;
+        results.reserve(m_targets.size());
+        for (std::size_t i = 0; m_results && i < m_targets.size(); i++)
+            results.push_back(std::move(m_results[i]));
+        return results;
+    }
+
+private:
+    /// Invoke unstarted targets until none remain.
+    void Claim() {
+        std::size_t finished = 0;
+        std::size_t index;
+        while ((index = m_next.fetch_add(1)) < m_targets.size()) {
+            if constexpr (std::is_void_v<RetType>) {
+                std::apply(*m_targets[index], m_args);
+            }
+            else {
+                if (!m_results)
+                    std::apply(*m_targets[index], m_args);
+                else
+                    m_results[index] = std::apply(*m_targets[index], m_args);
+            }
+            finished++;
+        }
+
+        if (finished > 0) {
+            const std::lock_guard<std::mutex> lock(m_lock);
+            m_finished += finished;
+            if (m_finished == m_targets.size())
+                m_cv.notify_one();
+        }
+    }
+
+    std::vector<DelegateType*> m_targets;
+    std::tuple<std::add_lvalue_reference_t<Args>...> m_args;
+
+    /// An array rather than a vector; concurrent stores to `std::vector<bool>`
+    /// elements would race.
+    std::unique_ptr<ResultType[]> m_results;
+
+    std::atomic<std::size_t> m_next{ 0 };
+    std::size_t m_finished = 0;
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+};
+
+}
+
+#endif
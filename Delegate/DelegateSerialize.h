@@ -0,0 +1,678 @@
+#ifndef _DELEGATE_SERIALIZE_H
+#define _DELEGATE_SERIALIZE_H
+
+/// @file
+/// @brief Compact binary serialization of event data and delegate arguments.
+///
+/// @details Values are encoded back to back with no tags or padding:
+///
+/// * Trivially copyable types, such as arithmetic types, enums and plain
+///   structs, are copied as raw bytes with `memcpy`.
+/// * Classes list their fields with the `SERIAL_FIELDS` macro. The fields are
+///   encoded in order; a derived class lists its base class fields too.
+/// * `std::string` and `std::vector` are a 32-bit count followed by the
+///   elements. A vector of trivially copyable elements is copied with a single
+///   `memcpy`.
+/// * `std::tuple`, `std::pair` and `std::array` encode each element in turn.
+///   `std::optional` is a presence byte followed by the value, if any.
+///
+/// A type whose fields are all fixed size has a compile time size,
+/// `serial_traits<T>::SIZE`, so it may be encoded into a stack buffer. Other
+/// types are sized with `SerialSize()` so the output is allocated once.
+///
+/// Decoding into `std::string_view` or `SerialSpan<T>` in place of
+/// `std::string` or `std::vector<T>` refers to the encoded bytes instead of
+/// copying them. The wire format is the same, so a view type may decode what a
+/// value type encoded; the view is valid while the buffer is.
+///
+///    struct MotorData : public EventData
+///    {
+///        INT speed;
+///        std::string reason;
+///        SERIAL_FIELDS(speed, reason)
+///    };
+///
+///    std::vector<std::uint8_t> bytes = Serialize(data);
+///    MotorData copy;
+///    if (Deserialize(bytes.data(), bytes.size(), copy))
+///        ...
+///
+/// `SerialArgs<>` encodes the arguments of a delegate signature and invokes a
+/// target with the decoded copies, e.g. to replay a call in another process.
+///
+/// Values are encoded in host byte order with host type sizes; the format is
+/// meant for processes and files on the same platform. Reading never trusts
+/// the input: a truncated or oversized count fails the read instead of reading
+/// beyond the buffer. Pointers are not serialized unless they are delegate
+/// arguments.
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// List the fields of a class to serialize, in encoding order. Place within the
+/// class definition.
+#define SERIAL_FIELDS(...) \
+    auto SerialFields() { return std::tie(__VA_ARGS__); } \
+    auto SerialFields() const { return std::tie(__VA_ARGS__); }
+
+namespace DelegateLib {
+
+/// @brief Encodes values into a caller supplied buffer. Fails instead of
+/// writing past the end.
+class SerialWriter
+{
+public:
+    /// Constructor
+    /// @param[in] buffer The output buffer.
+    /// @param[in] capacity The buffer size in bytes.
+    SerialWriter(void* buffer, std::size_t capacity) :
+        m_buffer(static_cast<std::uint8_t*>(buffer)), m_capacity(capacity), m_size(0), m_fail(false) {}
+
+    /// Append raw bytes.
+    /// @param[in] data The bytes to append.
+    /// @param[in] size The number of bytes.
+    void Write(const void* data, std::size_t size) {
+        if (m_fail || size > m_capacity - m_size) {
+            m_fail = true;
+            return;
+        }
+        if (size)
+            memcpy(m_buffer + m_size, data, size);
+        m_size += size;
+    }
+
+    /// Append a string or container element count.
+    /// @param[in] count The count. Fails if it exceeds 32 bits.
+    void WriteCount(std::size_t count) {
+        if (count > (std::numeric_limits<std::uint32_t>::max)()) {
+            m_fail = true;
+            return;
+        }
+        std::uint32_t value = static_cast<std::uint32_t>(count);
+        Write(&value, sizeof(value));
+    }
+
+    /// @return The number of bytes written.
+    std::size_t GetSize() const { return m_size; }
+
+    /// @return `true` if a write did not fit or a count was too large.
+    bool IsFail() const { return m_fail; }
+
+private:
+    std::uint8_t* m_buffer;
+    std::size_t m_capacity;
+    std::size_t m_size;
+    bool m_fail;
+};
+
+/// @brief Decodes values from an encoded buffer. Fails instead of reading past
+/// the end.
+class SerialReader
+{
+public:
+    /// Constructor
+    /// @param[in] data The encoded bytes.
+    /// @param[in] size The number of bytes.
+    SerialReader(const void* data, std::size_t size) :
+        m_data(static_cast<const std::uint8_t*>(data)), m_size(size), m_offset(0), m_fail(false) {}
+
+    /// Consume raw bytes without copying.
+    /// @param[in] size The number of bytes.
+    /// @return A pointer to the bytes within the buffer, or `nullptr` if fewer
+    /// bytes remain.
+    const std::uint8_t* Read(std::size_t size) {
+        if (m_fail || size > m_size - m_offset) {
+            m_fail = true;
+            return nullptr;
+        }
+        const std::uint8_t* data = m_data + m_offset;
+        m_offset += size;
+        return data;
+    }
+
+    /// Consume raw bytes into a value.
+    /// @param[out] data The destination.
+    /// @param[in] size The number of bytes.
+    /// @return `true` if the bytes were available.
+    bool Read(void* data, std::size_t size) {
+        const std::uint8_t* source = Read(size);
+        if (!source)
+            return false;
+        if (size)
+            memcpy(data, source, size);
+        return true;
+    }
+
+    /// Consume a string or container element count.
+    /// @param[out] count The count.
+    /// @return `true` if the count was available.
+    bool ReadCount(std::size_t& count) {
+        std::uint32_t value;
+        if (!Read(&value, sizeof(value)))
+            return false;
+        count = value;
+        return true;
+    }
+
+    /// @return The number of bytes not yet read.
+    std::size_t GetRemaining() const { return m_size - m_offset; }
+
+    /// @return `true` if a read exceeded the buffer or found invalid data.
+    bool IsFail() const { return m_fail; }
+
+    /// Mark the input invalid, e.g. on a count larger than the data.
+    void SetFail() { m_fail = true; }
+
+private:
+    const std::uint8_t* m_data;
+    std::size_t m_size;
+    std::size_t m_offset;
+    bool m_fail;
+};
+
+/// @brief A read only view of an encoded array, decoded in place of a
+/// `std::vector<T>` without copying the elements. Elements are loaded on
+/// access since the encoded bytes need not be aligned for `T`.
+template <class T>
+class SerialSpan
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SerialSpan elements must be trivially copyable");
+
+public:
+    SerialSpan() : m_data(nullptr), m_size(0) {}
+
+    /// Constructor to encode existing elements.
+    /// @param[in] data The first element.
+    /// @param[in] size The number of elements.
+    SerialSpan(const T* data, std::size_t size) :
+        m_data(reinterpret_cast<const std::uint8_t*>(data)), m_size(size) {}
+
+    /// @return The number of elements.
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    /// @return The encoded elements.
+    const void* data() const { return m_data; }
+
+    /// Load an element.
+    /// @param[in] index The element index.
+    /// @return A copy of the element.
+    T operator[](std::size_t index) const {
+        T value;
+        memcpy(&value, m_data + index * sizeof(T), sizeof(T));
+        return value;
+    }
+
+private:
+    const std::uint8_t* m_data;
+    std::size_t m_size;
+};
+
+template <class T, class Enable = void>
+struct serial_traits;
+
+template <class T, class Enable = void>
+struct has_serial_fields : std::false_type {};
+
+template <class T>
+struct has_serial_fields<T, std::void_t<decltype(std::declval<const T&>().SerialFields())>> : std::true_type {};
+
+template <class T>
+struct is_serial_view : std::false_type {};
+
+template <>
+struct is_serial_view<std::string_view> : std::true_type {};
+
+template <class T>
+struct is_serial_view<SerialSpan<T>> : std::true_type {};
+
+template <class T>
+struct is_optional : std::false_type {};
+
+template <class T>
+struct is_optional<std::optional<T>> : std::true_type {};
+
+/// @brief `true` if a type is encoded as its raw bytes.
+template <class T>
+struct is_serial_memcpy : std::integral_constant<bool,
+    std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value &&
+    !std::is_member_pointer<T>::value && !has_serial_fields<T>::value &&
+    !is_serial_view<T>::value && !is_optional<T>::value> {};
+
+/// @brief Encodes each element of a tuple in turn. A tuple of references, such
+/// as the one returned by `SerialFields()`, encodes the referenced values.
+template <class... Ts>
+struct serial_tuple
+{
+    static constexpr bool FIXED = (serial_traits<std::decay_t<Ts>>::FIXED && ... && true);
+    static constexpr std::size_t SIZE = FIXED ? (serial_traits<std::decay_t<Ts>>::SIZE + ... + 0) : 0;
+
+    static std::size_t Size(const std::tuple<Ts...>& value) {
+        if constexpr (FIXED)
+            return SIZE;
+        else
+            return std::apply([](const auto&... elem) {
+                return (serial_traits<std::decay_t<decltype(elem)>>::Size(elem) + ... + 0);
+            }, value);
+    }
+
+    static void Write(SerialWriter& writer, const std::tuple<Ts...>& value) {
+        std::apply([&writer](const auto&... elem) {
+            (serial_traits<std::decay_t<decltype(elem)>>::Write(writer, elem), ...);
+        }, value);
+    }
+
+    template <class Tuple>
+    static bool Read(SerialReader& reader, Tuple&& value) {
+        return std::apply([&reader](auto&... elem) {
+            return (serial_traits<std::decay_t<decltype(elem)>>::Read(reader, elem) && ... && true);
+        }, value);
+    }
+};
+
+/// @brief Describes how a type is encoded. Specialize for types that can
+/// neither be copied as raw bytes nor list their fields with `SERIAL_FIELDS`.
+///
+/// @details A specialization provides `FIXED`, `true` if every value encodes to
+/// `SIZE` bytes, and the static functions `Size()`, `Write()` and `Read()`.
+template <class T, class Enable>
+struct serial_traits
+{
+    static_assert(sizeof(T) == 0, "Type is not serializable. Use SERIAL_FIELDS or specialize serial_traits.");
+};
+
+/// @brief Trivially copyable types are copied as raw bytes
+template <class T>
+struct serial_traits<T, std::enable_if_t<is_serial_memcpy<T>::value>>
+{
+    static constexpr bool FIXED = true;
+    static constexpr std::size_t SIZE = sizeof(T);
+
+    static std::size_t Size(const T&) { return SIZE; }
+    static void Write(SerialWriter& writer, const T& value) { writer.Write(&value, sizeof(T)); }
+    static bool Read(SerialReader& reader, T& value) { return reader.Read(&value, sizeof(T)); }
+};
+
+/// @brief Classes listing their fields with SERIAL_FIELDS
+template <class T>
+struct serial_traits<T, std::enable_if_t<has_serial_fields<T>::value>>
+{
+    using Fields = decltype(std::declval<const T&>().SerialFields());
+    using Tuple = serial_traits<Fields>;
+
+    static constexpr bool FIXED = Tuple::FIXED;
+    static constexpr std::size_t SIZE = Tuple::SIZE;
+
+    static std::size_t Size(const T& value) { return Tuple::Size(value.SerialFields()); }
+    static void Write(SerialWriter& writer, const T& value) { Tuple::Write(writer, value.SerialFields()); }
+    static bool Read(SerialReader& reader, T& value) { return Tuple::Read(reader, value.SerialFields()); }
+};
+
+template <class... Ts>
+struct serial_traits<std::tuple<Ts...>> : serial_tuple<Ts...> {};
+
+template <class T1, class T2>
+struct serial_traits<std::pair<T1, T2>, std::enable_if_t<!is_serial_memcpy<std::pair<T1, T2>>::value>>
+{
+    using Tuple = serial_tuple<T1, T2>;
+
+    static constexpr bool FIXED = Tuple::FIXED;
+    static constexpr std::size_t SIZE = Tuple::SIZE;
+
+    static std::size_t Size(const std::pair<T1, T2>& value) { return Tuple::Size(std::tie(value.first, value.second)); }
+    static void Write(SerialWriter& writer, const std::pair<T1, T2>& value) { Tuple::Write(writer, std::tie(value.first, value.second)); }
+    static bool Read(SerialReader& reader, std::pair<T1, T2>& value) { return Tuple::Read(reader, std::tie(value.first, value.second)); }
+};
+
+/// @brief Arrays of elements that are not trivially copyable encode each element
+template <class T, std::size_t N>
+struct serial_traits<std::array<T, N>, std::enable_if_t<!is_serial_memcpy<std::array<T, N>>::value>>
+{
+    static constexpr bool FIXED = serial_traits<T>::FIXED;
+    static constexpr std::size_t SIZE = FIXED ? serial_traits<T>::SIZE * N : 0;
+
+    static std::size_t Size(const std::array<T, N>& value) {
+        if constexpr (FIXED)
+            return SIZE;
+        std::size_t size = 0;
+        for (const T& elem : value)
+            size += serial_traits<T>::Size(elem);
+        return size;
+    }
+    static void Write(SerialWriter& writer, const std::array<T, N>& value) {
+        for (const T& elem : value)
+            serial_traits<T>::Write(writer, elem);
+    }
+    static bool Read(SerialReader& reader, std::array<T, N>& value) {
+        for (T& elem : value) {
+            if (!serial_traits<T>::Read(reader, elem))
+                return false;
+        }
+        return true;
+    }
+};
+
+template <class T>
+struct serial_traits<std::optional<T>>
+{
+    static constexpr bool FIXED = false;
+    static constexpr std::size_t SIZE = 0;
+
+    static std::size_t Size(const std::optional<T>& value) {
+        return sizeof(std::uint8_t) + (value ? serial_traits<T>::Size(*value) : 0);
+    }
+    static void Write(SerialWriter& writer, const std::optional<T>& value) {
+        std::uint8_t present = value ? 1 : 0;
+        writer.Write(&present, sizeof(present));
+        if (value)
+            serial_traits<T>::Write(writer, *value);
+    }
+    static bool Read(SerialReader& reader, std::optional<T>& value) {
+        std::uint8_t present;
+        if (!reader.Read(&present, sizeof(present)))
+            return false;
+        if (!present) {
+            value.reset();
+            return true;
+        }
+        if (!value)
+            value.emplace();
+        return serial_traits<T>::Read(reader, *value);
+    }
+};
+
+template <>
+struct serial_traits<std::string>
+{
+    static constexpr bool FIXED = false;
+    static constexpr std::size_t SIZE = 0;
+
+    static std::size_t Size(const std::string& value) { return sizeof(std::uint32_t) + value.size(); }
+    static void Write(SerialWriter& writer, const std::string& value) {
+        writer.WriteCount(value.size());
+        writer.Write(value.data(), value.size());
+    }
+    static bool Read(SerialReader& reader, std::string& value) {
+        std::size_t count;
+        if (!reader.ReadCount(count))
+            return false;
+        const std::uint8_t* data = reader.Read(count);
+        if (!data)
+            return false;
+        value.assign(reinterpret_cast<const char*>(data), count);
+        return true;
+    }
+};
+
+/// @brief Decodes a string as a view of the encoded bytes
+template <>
+struct serial_traits<std::string_view>
+{
+    static constexpr bool FIXED = false;
+    static constexpr std::size_t SIZE = 0;
+
+    static std::size_t Size(const std::string_view& value) { return sizeof(std::uint32_t) + value.size(); }
+    static void Write(SerialWriter& writer, const std::string_view& value) {
+        writer.WriteCount(value.size());
+        writer.Write(value.data(), value.size());
+    }
+    static bool Read(SerialReader& reader, std::string_view& value) {
+        std::size_t count;
+        if (!reader.ReadCount(count))
+            return false;
+        const std::uint8_t* data = reader.Read(count);
+        if (!data)
+            return false;
+        value = std::string_view(reinterpret_cast<const char*>(data), count);
+        return true;
+    }
+};
+
+template <class T, class Alloc>
+struct serial_traits<std::vector<T, Alloc>>
+{
+    static constexpr bool FIXED = false;
+    static constexpr std::size_t SIZE = 0;
+
+    static std::size_t Size(const std::vector<T, Alloc>& value) {
+        std::size_t size = sizeof(std::uint32_t);
+        if constexpr (serial_traits<T>::FIXED)
+            return size + value.size() * serial_traits<T>::SIZE;
+        for (const T& elem : value)
+            size += serial_traits<T>::Size(elem);
+        return size;
+    }
+    static void Write(SerialWriter& writer, const std::vector<T, Alloc>& value) {
+        writer.WriteCount(value.size());
+        if constexpr (is_serial_memcpy<T>::value) {
+            writer.Write(value.data(), value.size() * sizeof(T));
+        } else {
+            for (const T& elem : value)
+                serial_traits<T>::Write(writer, elem);
+        }
+    }
+    static bool Read(SerialReader& reader, std::vector<T, Alloc>& value) {
+        std::size_t count;
+        if (!reader.ReadCount(count))
+            return false;
+        if constexpr (is_serial_memcpy<T>::value) {
+            const std::uint8_t* data = reader.Read(count * sizeof(T));
+            if (!data)
+                return false;
+            value.resize(count);
+            if (count)
+                memcpy(value.data(), data, count * sizeof(T));
+            return true;
+        } else {
+            // Grow as elements decode so a corrupt count cannot allocate
+            // beyond the input
+            value.clear();
+            for (std::size_t i = 0; i < count; i++) {
+                value.emplace_back();
+                if (!serial_traits<T>::Read(reader, value.back()))
+                    return false;
+            }
+            return true;
+        }
+    }
+};
+
+/// @brief Decodes an array of trivially copyable elements as a view of the
+/// encoded bytes
+template <class T>
+struct serial_traits<SerialSpan<T>>
+{
+    static constexpr bool FIXED = false;
+    static constexpr std::size_t SIZE = 0;
+
+    static std::size_t Size(const SerialSpan<T>& value) { return sizeof(std::uint32_t) + value.size() * sizeof(T); }
+    static void Write(SerialWriter& writer, const SerialSpan<T>& value) {
+        writer.WriteCount(value.size());
+        writer.Write(value.data(), value.size() * sizeof(T));
+    }
+    static bool Read(SerialReader& reader, SerialSpan<T>& value) {
+        std::size_t count;
+        if (!reader.ReadCount(count))
+            return false;
+        const std::uint8_t* data = reader.Read(count * sizeof(T));
+        if (!data)
+            return false;
+        value = SerialSpan<T>(reinterpret_cast<const T*>(data), count);
+        return true;
+    }
+};
+
+/// Get the encoded size of a value.
+/// @param[in] value The value.
+/// @return The size in bytes.
+template <class T>
+std::size_t SerialSize(const T& value) {
+    return serial_traits<T>::Size(value);
+}
+
+/// Encode a value.
+/// @param[in] writer The destination.
+/// @param[in] value The value.
+/// @return `true` if the value fit within the buffer.
+template <class T>
+bool SerialWrite(SerialWriter& writer, const T& value) {
+    serial_traits<T>::Write(writer, value);
+    return !writer.IsFail();
+}
+
+/// Decode a value.
+/// @param[in] reader The source.
+/// @param[out] value The value. Partially decoded on failure.
+/// @return `true` if the value was decoded.
+template <class T>
+bool SerialRead(SerialReader& reader, T& value) {
+    if (!serial_traits<T>::Read(reader, value))
+        reader.SetFail();
+    return !reader.IsFail();
+}
+
+/// Encode a value into a buffer allocated to fit.
+/// @param[in] value The value.
+/// @return The encoded bytes, or an empty buffer if a count exceeds 32 bits.
+/// @throws std::bad_alloc If dynamic memory allocation fails.
+template <class T>
+std::vector<std::uint8_t> Serialize(const T& value) {
+    std::vector<std::uint8_t> buffer(SerialSize(value));
+    SerialWriter writer(buffer.data(), buffer.size());
+    if (!SerialWrite(writer, value))
+        buffer.clear();
+    return buffer;
+}
+
+/// Decode a value that occupies the whole buffer.
+/// @param[in] data The encoded bytes.
+/// @param[in] size The number of bytes.
+/// @param[out] value The value.
+/// @return `true` if the value was decoded and every byte consumed.
+template <class T>
+bool Deserialize(const void* data, std::size_t size, T& value) {
+    SerialReader reader(data, size);
+    return SerialRead(reader, value) && reader.GetRemaining() == 0;
+}
+
+/// @brief Encoding and decoded storage of one delegate argument. By value and
+/// reference arguments are stored by value.
+template <class Arg>
+struct serial_arg
+{
+    static_assert(!std::is_rvalue_reference<Arg>::value, "Rvalue reference arguments are not serializable");
+
+    using storage = std::remove_cv_t<std::remove_reference_t<Arg>>;
+
+    static std::size_t Size(const storage& arg) { return serial_traits<storage>::Size(arg); }
+    static void Write(SerialWriter& writer, const storage& arg) { serial_traits<storage>::Write(writer, arg); }
+    static storage& Get(storage& stored) { return stored; }
+};
+
+/// @brief Pointer arguments encode the pointed to value, or null
+template <class T>
+struct serial_arg<T*>
+{
+    static_assert(!std::is_pointer<T>::value, "Pointer to pointer arguments are not serializable");
+    static_assert(!std::is_void<T>::value, "void* arguments are not serializable");
+
+    using storage = std::optional<std::remove_cv_t<T>>;
+
+    static std::size_t Size(const T* arg) {
+        return sizeof(std::uint8_t) + (arg ? serial_traits<std::remove_cv_t<T>>::Size(*arg) : 0);
+    }
+    static void Write(SerialWriter& writer, const T* arg) {
+        std::uint8_t present = arg ? 1 : 0;
+        writer.Write(&present, sizeof(present));
+        if (arg)
+            serial_traits<std::remove_cv_t<T>>::Write(writer, *arg);
+    }
+    static T* Get(storage& stored) { return stored ? &*stored : nullptr; }
+};
+
+template <class T>
+struct serial_arg<T* const> : serial_arg<T*> {};
+
+/// @brief Encodes the arguments of a delegate signature and decodes them into
+/// copies that a target may be invoked with.
+///
+/// @details A pointer argument encodes the pointed to value and decodes into a
+/// copy passed by pointer; a null pointer stays null.
+///
+///    // Sender
+///    using Args = SerialArgs<int, const std::string&, const Data*>;
+///    std::vector<std::uint8_t> bytes(Args::Size(id, name, &data));
+///    SerialWriter writer(bytes.data(), bytes.size());
+///    Args::Write(writer, id, name, &data);
+///
+///    // Receiver
+///    Args args;
+///    SerialReader reader(bytes.data(), bytes.size());
+///    if (args.Read(reader))
+///        args.Invoke(delegate);
+///
+/// A queued `DelegateAsyncMsg` may be encoded with `std::apply()` on its
+/// `GetArgs()` tuple.
+template <class... Args>
+class SerialArgs
+{
+public:
+    /// Get the encoded size of the arguments.
+    static std::size_t Size(const std::remove_reference_t<Args>&... args) {
+        return (serial_arg<Args>::Size(args) + ... + 0);
+    }
+
+    /// Encode the arguments.
+    /// @return `true` if the arguments fit within the buffer.
+    static bool Write(SerialWriter& writer, const std::remove_reference_t<Args>&... args) {
+        (serial_arg<Args>::Write(writer, args), ...);
+        return !writer.IsFail();
+    }
+
+    /// Decode arguments into this instance.
+    /// @param[in] reader The source.
+    /// @return `true` if every argument was decoded.
+    bool Read(SerialReader& reader) {
+        return serial_tuple<typename serial_arg<Args>::storage...>::Read(reader, m_storage) && !reader.IsFail();
+    }
+
+    /// Invoke a target with the decoded arguments. Reference and pointer
+    /// arguments refer to the copies held by this instance.
+    /// @param[in] func The target function, delegate or other callable.
+    /// @return The target return value.
+    template <class F>
+    decltype(auto) Invoke(F&& func) {
+        return InvokeImpl(std::forward<F>(func), std::index_sequence_for<Args...>());
+    }
+
+    /// @return The decoded arguments, referring to the copies held by this instance.
+    std::tuple<Args...> GetArgs() {
+        return GetArgsImpl(std::index_sequence_for<Args...>());
+    }
+
+private:
+    template <class F, std::size_t... Index>
+    decltype(auto) InvokeImpl(F&& func, std::index_sequence<Index...>) {
+        return std::forward<F>(func)(serial_arg<Args>::Get(std::get<Index>(m_storage))...);
+    }
+
+    template <std::size_t... Index>
+    std::tuple<Args...> GetArgsImpl(std::index_sequence<Index...>) {
+        return std::tuple<Args...>(serial_arg<Args>::Get(std::get<Index>(m_storage))...);
+    }
+
+    std::tuple<typename serial_arg<Args>::storage...> m_storage;
+};
+
+} // namespace DelegateLib
+
+#endif
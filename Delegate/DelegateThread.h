@@ -2,6 +2,7 @@
 #define _DELEGATE_THREAD_H
 
 #include "DelegateMsg.h"
+#include "DelegateArena.h"
 
 namespace DelegateLib {
 
@@ -26,6 +27,11 @@ public:
 	/// @pre Caller *must* create the DelegateMsg argument dynamically.
 	/// @post The destination thread calls DelegateInvoke().
 	virtual void DispatchDelegate(std::shared_ptr<DelegateMsg> msg) = 0;
+
+	/// Get the arena that asynchronous messages dispatched to this thread are
+	/// allocated from.
+	/// @return The arena, or nullptr to allocate messages from the heap.
+	virtual std::shared_ptr<DelegateArena> GetArena() { return nullptr; }
 };
 
 }
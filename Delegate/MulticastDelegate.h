@@ -6,9 +6,12 @@
 /// delegate instances. Class is not thread-safe.
 
 #include "Delegate.h"
+#include "DelegateParallel.h"
 #include <list>
 #include <algorithm>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace DelegateLib {
 
@@ -53,6 +56,31 @@ public:
         (*this)(args...);
     }
 
+    /// Invoke all bound target functions in parallel and wait for all of them
+    /// to finish. The calling thread runs targets alongside the helper threads.
+    /// @details Intended for independent, CPU bound synchronous targets. Every
+    /// target receives the caller's arguments by reference rather than a copy;
+    /// targets must not modify a shared argument. See `ParallelJob<>`.
+    /// @param[in] threads The helper threads, e.g. `Strand` instances of a `ThreadPool`.
+    /// @param[in] maxConcurrency The maximum number of targets running at once,
+    /// including the calling thread. 0 for no limit.
+    /// @param[in] args The arguments used when invoking the target functions
+    void ParallelBroadcast(const std::vector<DelegateThread*>& threads, std::size_t maxConcurrency, Args... args) {
+        RunParallel(threads, maxConcurrency, false, args...);
+    }
+
+    /// Invoke all bound target functions in parallel and collect the return values.
+    /// @see ParallelBroadcast
+    /// @param[in] threads The helper threads.
+    /// @param[in] maxConcurrency The maximum number of targets running at once,
+    /// including the calling thread. 0 for no limit.
+    /// @param[in] args The arguments used when invoking the target functions
+    /// @return The return values in insertion order.
+    template <class R = RetType, class = std::enable_if_t<!std::is_void_v<R>>>
+    std::vector<std::decay_t<R>> ParallelGather(const std::vector<DelegateThread*>& threads, std::size_t maxConcurrency, Args... args) {
+        return RunParallel(threads, maxConcurrency, true, args...)->TakeResults();
+    }
+
     /// Insert a delegate into the container.
     /// @param[in] delegate A delegate target to insert
     void operator+=(const DelegateType& delegate) { PushBack(delegate); }
@@ -141,6 +169,22 @@ public:
     explicit operator bool() const { return !Empty(); }
 
 private:
+    /// Run a parallel job over a snapshot of the container.
+    /// @return The finished job.
+    std::shared_ptr<ParallelJob<RetType(Args...)>> RunParallel(const std::vector<DelegateThread*>& threads,
+        std::size_t maxConcurrency, bool gather, Args&... args) {
+        std::vector<DelegateType*> targets;
+        targets.reserve(m_delegates.size());
+        for (auto& delegate : m_delegates)
+            targets.push_back(delegate.get());
+
+        auto job = std::make_shared<ParallelJob<RetType(Args...)>>(std::move(targets), gather, args...);
+        if (!job)
+            BAD_ALLOC();
+        ParallelJob<RetType(Args...)>::Run(job, threads, maxConcurrency);
+        return job;
+    }
+
     /// Copy all delegate container objects.
     /// @param[in] other The container to copy from
     void CopyFrom(const MulticastDelegate& other) {
@@ -42,6 +42,22 @@ public:
         BaseType::Broadcast(args...);
     }
 
+    /// Invoke all bound target functions in parallel and wait for all of them
+    /// to finish. The container is locked until the targets finish.
+    /// @see MulticastDelegate::ParallelBroadcast
+    void ParallelBroadcast(const std::vector<DelegateThread*>& threads, std::size_t maxConcurrency, Args... args) {
+        const std::lock_guard<std::mutex> lock(m_lock);
+        BaseType::ParallelBroadcast(threads, maxConcurrency, args...);
+    }
+
+    /// Invoke all bound target functions in parallel and collect the return values.
+    /// @see MulticastDelegate::ParallelGather
+    template <class R = RetType, class = std::enable_if_t<!std::is_void_v<R>>>
+    std::vector<std::decay_t<R>> ParallelGather(const std::vector<DelegateThread*>& threads, std::size_t maxConcurrency, Args... args) {
+        const std::lock_guard<std::mutex> lock(m_lock);
+        return BaseType::ParallelGather(threads, maxConcurrency, args...);
+    }
+
     /// Insert a delegate into the container.
     /// @param[in] delegate A delegate target to insert
     void operator+=(const Delegate<RetType(Args...)>& delegate) {
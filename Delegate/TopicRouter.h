@@ -0,0 +1,205 @@
+#ifndef _TOPIC_ROUTER_H
+#define _TOPIC_ROUTER_H
+
+/// @file
+/// @brief Delegate container routing invocations by hierarchical topic name.
+/// Class is thread safe.
+
+#include "MulticastDelegate.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace DelegateLib {
+
+template <class R>
+class TopicRouter; // Not defined
+
+/// @brief Thread-safe publish/subscribe router keyed by hierarchical topics
+/// such as `selftest/centrifuge/speed`.
+///
+/// @details Topic levels are separated by `/`. A subscription filter may use
+/// wildcard levels:
+///
+/// * `+` matches exactly one level, e.g. `selftest/+/speed`.
+/// * `#` as the last level matches the parent level and any number of levels
+///   below it, e.g. `selftest/#`. A filter of `#` alone matches every topic.
+///
+/// Filters are compiled into a trie when subscribed. Publish() walks the trie
+/// one topic level at a time, following the exact and `+` branches, so the cost
+/// grows with the topic depth rather than the number of subscriptions. No heap
+/// allocation occurs while matching.
+///
+/// Each subscription stores a delegate. Bind an asynchronous delegate to deliver
+/// on the subscriber's `DelegateThread`. As with `MulticastDelegateSafe<>`,
+/// delegates are invoked while the router lock is held; a synchronous target
+/// must not call back into the router.
+template <class RetType, class... Args>
+class TopicRouter<RetType(Args...)>
+{
+public:
+    using DelegateType = Delegate<RetType(Args...)>;
+
+    TopicRouter() = default;
+    TopicRouter(const TopicRouter&) = delete;
+    TopicRouter& operator=(const TopicRouter&) = delete;
+
+    /// Subscribe a delegate to all topics matching a filter.
+    /// @param[in] filter The topic filter, optionally with `+` and `#` levels.
+    /// @param[in] delegate A delegate target to insert. A clone is stored.
+    void Subscribe(const std::string& filter, const DelegateType& delegate) {
+        const std::lock_guard<std::mutex> lock(m_lock);
+        Node* node = &m_root;
+        std::string_view rest(filter);
+        while (true) {
+            std::string_view level = NextLevel(rest);
+            if (level == "#") {
+                node->remainder.PushBack(delegate);
+                return;
+            }
+
+            std::unique_ptr<Node>& child = (level == "+") ? node->single : node->children[std::string(level)];
+            if (!child) {
+                child.reset(new(std::nothrow) Node());
+                if (!child)
+                    BAD_ALLOC();
+            }
+            node = child.get();
+
+            if (rest.data() == nullptr)
+                break;
+        }
+        node->exact.PushBack(delegate);
+    }
+
+    /// Unsubscribe a delegate previously subscribed with the same filter.
+    /// @param[in] filter The topic filter used to subscribe.
+    /// @param[in] delegate The delegate target to remove.
+    void Unsubscribe(const std::string& filter, const DelegateType& delegate) {
+        const std::lock_guard<std::mutex> lock(m_lock);
+        Remove(m_root, std::string_view(filter), delegate);
+    }
+
+    /// Invoke every delegate subscribed to a filter matching the topic.
+    /// @param[in] topic The topic name. Wildcard characters have no special
+    /// meaning within a published topic.
+    /// @param[in] args The arguments used when invoking the target functions.
+    /// @return The number of delegates invoked.
+    std::size_t Publish(std::string_view topic, Args... args) {
+        const std::lock_guard<std::mutex> lock(m_lock);
+        return Match(m_root, topic, args...);
+    }
+
+    /// Any registered delegates?
+    /// @return `true` if no delegates are subscribed.
+    bool Empty() {
+        const std::lock_guard<std::mutex> lock(m_lock);
+        return m_root.IsEmpty();
+    }
+
+    /// Remove all subscriptions.
+    void Clear() {
+        const std::lock_guard<std::mutex> lock(m_lock);
+        m_root.exact.Clear();
+        m_root.remainder.Clear();
+        m_root.children.clear();
+        m_root.single.reset();
+    }
+
+private:
+    /// One topic level within the trie.
+    struct Node {
+        /// Child levels by exact name. Transparent comparison allows lookup by
+        /// `std::string_view` without allocation.
+        std::map<std::string, std::unique_ptr<Node>, std::less<>> children;
+
+        /// Child level for a `+` filter level.
+        std::unique_ptr<Node> single;
+
+        /// Subscribers to the topic ending at this level.
+        MulticastDelegate<RetType(Args...)> exact;
+
+        /// Subscribers to `#` at this level.
+        MulticastDelegate<RetType(Args...)> remainder;
+
+        bool IsEmpty() const {
+            return exact.Empty() && remainder.Empty() && children.empty() && !single;
+        }
+    };
+
+    /// Split the next level from a topic.
+    /// @param[in,out] rest The remaining topic. Set to a null view after the last level.
+    /// @return The next level.
+    static std::string_view NextLevel(std::string_view& rest) {
+        std::size_t pos = rest.find('/');
+        std::string_view level = rest.substr(0, pos);
+        if (pos == std::string_view::npos)
+            rest = std::string_view();
+        else
+            rest.remove_prefix(pos + 1);
+        return level;
+    }
+
+    /// Invoke the subscribers of node and its matching descendants.
+    std::size_t Match(Node& node, std::string_view rest, Args&... args) {
+        std::size_t count = node.remainder.Size();
+        node.remainder(args...);
+
+        if (rest.data() == nullptr) {
+            count += node.exact.Size();
+            node.exact(args...);
+            return count;
+        }
+
+        std::string_view level = NextLevel(rest);
+        auto it = node.children.find(level);
+        if (it != node.children.end())
+            count += Match(*it->second, rest, args...);
+        if (node.single)
+            count += Match(*node.single, rest, args...);
+        return count;
+    }
+
+    /// Remove a delegate from the node matching a filter and prune empty nodes.
+    /// @return `true` if node is left empty.
+    bool Remove(Node& node, std::string_view rest, const DelegateType& delegate) {
+        std::string_view level = NextLevel(rest);
+        if (level == "#") {
+            node.remainder.Remove(delegate);
+            return node.IsEmpty();
+        }
+
+        if (level == "+") {
+            if (node.single && RemoveFrom(*node.single, rest, delegate))
+                node.single.reset();
+        }
+        else {
+            auto it = node.children.find(level);
+            if (it != node.children.end() && RemoveFrom(*it->second, rest, delegate))
+                node.children.erase(it);
+        }
+        return node.IsEmpty();
+    }
+
+    /// Remove a delegate from child, or from its matching descendant.
+    /// @return `true` if child is left empty.
+    bool RemoveFrom(Node& child, std::string_view rest, const DelegateType& delegate) {
+        if (rest.data() == nullptr) {
+            child.exact.Remove(delegate);
+            return child.IsEmpty();
+        }
+        return Remove(child, rest, delegate);
+    }
+
+    /// The root level. A topic's first level is a child of the root.
+    Node m_root;
+
+    /// Lock to make the class thread-safe
+    std::mutex m_lock;
+};
+
+}
+
+#endif
@@ -103,6 +103,34 @@ private:
     T** m_arg;
 };
 
+/// @brief Approximate bookkeeping bytes per heap argument: the deleter's shared
+/// pointer control block and the list node holding the shared pointer.
+constexpr std::size_t HEAP_ARG_OVERHEAD = 4 * sizeof(void*) + sizeof(std::shared_ptr<heap_arg_deleter_base>);
+
+/// @brief Approximate bytes allocated by `tuple_append()` for an argument. By
+/// value arguments are stored within the tuple and allocate nothing.
+template<typename Arg>
+struct heap_arg_size : std::integral_constant<std::size_t, 0> {};
+
+template<typename T>
+struct heap_arg_size<T&> : std::integral_constant<std::size_t, 
+    sizeof(T) + sizeof(heap_arg_deleter<T*>) + HEAP_ARG_OVERHEAD> {};
+
+template<typename T>
+struct heap_arg_size<T*> : std::integral_constant<std::size_t, 
+    sizeof(T) + sizeof(heap_arg_deleter<T*>) + HEAP_ARG_OVERHEAD> {};
+
+template<typename T>
+struct heap_arg_size<T**> : std::integral_constant<std::size_t, 
+    sizeof(T*) + sizeof(T) + sizeof(heap_arg_deleter<T**>) + HEAP_ARG_OVERHEAD> {};
+
+// void* arguments are rejected by make_tuple_heap()
+template<>
+struct heap_arg_size<void*> : std::integral_constant<std::size_t, 0> {};
+
+template<>
+struct heap_arg_size<const void*> : std::integral_constant<std::size_t, 0> {};
+
 /// @brief Append a pointer to pointer argument to the tuple
 template <typename Arg, typename... TupleElem>
 auto tuple_append(xlist<std::shared_ptr<heap_arg_deleter_base>>& heapArgs, const std::tuple<TupleElem...> &tup, Arg** arg)
@@ -0,0 +1,205 @@
+#include "LatencyHistogram.h"
+#include <limits>
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+// HighestBit
+//------------------------------------------------------------------------------
+static int HighestBit(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return 63 - __builtin_clzll(value);
+#else
+	int bit = 0;
+	while (value >>= 1)
+		bit++;
+	return bit;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// LatencySnapshot
+//------------------------------------------------------------------------------
+LatencySnapshot::LatencySnapshot() :
+	m_counts(LatencyHistogram::BUCKET_COUNT, 0),
+	m_count(0),
+	m_sum(0),
+	m_min(numeric_limits<uint64_t>::max()),
+	m_max(0)
+{
+}
+
+//------------------------------------------------------------------------------
+// Merge
+//------------------------------------------------------------------------------
+void LatencySnapshot::Merge(const LatencySnapshot& other)
+{
+	for (int i = 0; i < LatencyHistogram::BUCKET_COUNT; i++)
+		m_counts[i] += other.m_counts[i];
+
+	m_count += other.m_count;
+	m_sum += other.m_sum;
+	if (other.m_min < m_min)
+		m_min = other.m_min;
+	if (other.m_max > m_max)
+		m_max = other.m_max;
+}
+
+//------------------------------------------------------------------------------
+// GetPercentile
+//------------------------------------------------------------------------------
+uint64_t LatencySnapshot::GetPercentile(double percentile) const
+{
+	if (m_count == 0)
+		return 0;
+
+	if (percentile < 0.0)
+		percentile = 0.0;
+	if (percentile > 100.0)
+		percentile = 100.0;
+
+	// Rank of the value at the percentile, at least the first value
+	uint64_t rank = uint64_t((percentile / 100.0) * double(m_count) + 0.5);
+	if (rank == 0)
+		rank = 1;
+
+	uint64_t total = 0;
+	for (int i = 0; i < LatencyHistogram::BUCKET_COUNT; i++)
+	{
+		total += m_counts[i];
+		if (total >= rank)
+		{
+			// Bucket upper bound, but never beyond the exact recorded extremes
+			uint64_t value = LatencyHistogram::GetBucketUpperBound(i);
+			if (value > m_max)
+				value = m_max;
+			if (value < m_min)
+				value = m_min;
+			return value;
+		}
+	}
+	return m_max;
+}
+
+//------------------------------------------------------------------------------
+// LatencyHistogram
+//------------------------------------------------------------------------------
+LatencyHistogram::LatencyHistogram(int shards) :
+	m_shardCount(shards > 0 ? shards : 1),
+	m_shards(new Shard[m_shardCount])
+{
+	Reset();
+}
+
+//------------------------------------------------------------------------------
+// ~LatencyHistogram
+//------------------------------------------------------------------------------
+LatencyHistogram::~LatencyHistogram()
+{
+}
+
+//------------------------------------------------------------------------------
+// GetBucketIndex
+//------------------------------------------------------------------------------
+int LatencyHistogram::GetBucketIndex(uint64_t value)
+{
+	// Small values map one-to-one onto the first linear buckets
+	if (value < uint64_t(SUB_BUCKET_COUNT))
+		return int(value);
+
+	int bit = HighestBit(value);
+	if (bit >= MAX_VALUE_BITS)
+		return BUCKET_COUNT - 1;
+
+	// Keep the SUB_BUCKET_BITS most significant bits below the leading one
+	int shift = bit - SUB_BUCKET_BITS;
+	return (shift + 1) * SUB_BUCKET_COUNT + int(value >> shift) - SUB_BUCKET_COUNT;
+}
+
+//------------------------------------------------------------------------------
+// GetBucketUpperBound
+//------------------------------------------------------------------------------
+uint64_t LatencyHistogram::GetBucketUpperBound(int index)
+{
+	if (index < SUB_BUCKET_COUNT)
+		return uint64_t(index);
+
+	int shift = index / SUB_BUCKET_COUNT - 1;
+	uint64_t sub = uint64_t(index % SUB_BUCKET_COUNT);
+	return ((uint64_t(SUB_BUCKET_COUNT) + sub) << shift) + ((uint64_t(1) << shift) - 1);
+}
+
+//------------------------------------------------------------------------------
+// GetShard
+//------------------------------------------------------------------------------
+LatencyHistogram::Shard& LatencyHistogram::GetShard()
+{
+	// Each thread is given a sequential index on first use so that up to
+	// m_shardCount threads each record into a private shard
+	static atomic<unsigned> nextThreadIndex(0);
+	static thread_local unsigned threadIndex = nextThreadIndex.fetch_add(1, memory_order_relaxed);
+	return m_shards[threadIndex % unsigned(m_shardCount)];
+}
+
+//------------------------------------------------------------------------------
+// Record
+//------------------------------------------------------------------------------
+void LatencyHistogram::Record(uint64_t value)
+{
+	Shard& shard = GetShard();
+
+	shard.counts[GetBucketIndex(value)].fetch_add(1, memory_order_relaxed);
+	shard.sum.fetch_add(value, memory_order_relaxed);
+
+	// Extremes rarely change so the compare-exchange loops seldom execute
+	uint64_t current = shard.min.load(memory_order_relaxed);
+	while (value < current && !shard.min.compare_exchange_weak(current, value, memory_order_relaxed))
+		;
+	current = shard.max.load(memory_order_relaxed);
+	while (value > current && !shard.max.compare_exchange_weak(current, value, memory_order_relaxed))
+		;
+}
+
+//------------------------------------------------------------------------------
+// GetSnapshot
+//------------------------------------------------------------------------------
+LatencySnapshot LatencyHistogram::GetSnapshot() const
+{
+	LatencySnapshot snapshot;
+	for (int s = 0; s < m_shardCount; s++)
+	{
+		const Shard& shard = m_shards[s];
+		for (int i = 0; i < BUCKET_COUNT; i++)
+		{
+			uint64_t count = shard.counts[i].load(memory_order_relaxed);
+			snapshot.m_counts[i] += count;
+			snapshot.m_count += count;
+		}
+		snapshot.m_sum += shard.sum.load(memory_order_relaxed);
+
+		uint64_t min = shard.min.load(memory_order_relaxed);
+		uint64_t max = shard.max.load(memory_order_relaxed);
+		if (min < snapshot.m_min)
+			snapshot.m_min = min;
+		if (max > snapshot.m_max)
+			snapshot.m_max = max;
+	}
+	return snapshot;
+}
+
+//------------------------------------------------------------------------------
+// Reset
+//------------------------------------------------------------------------------
+void LatencyHistogram::Reset()
+{
+	for (int s = 0; s < m_shardCount; s++)
+	{
+		Shard& shard = m_shards[s];
+		for (int i = 0; i < BUCKET_COUNT; i++)
+			shard.counts[i].store(0, memory_order_relaxed);
+		shard.sum.store(0, memory_order_relaxed);
+		shard.min.store(numeric_limits<uint64_t>::max(), memory_order_relaxed);
+		shard.max.store(0, memory_order_relaxed);
+	}
+}
@@ -0,0 +1,124 @@
+#ifndef _LATENCY_HISTOGRAM_H
+#define _LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// @brief A point-in-time copy of a LatencyHistogram. Snapshots from different
+/// histograms, or taken at different times, can be merged together and queried
+/// for percentiles. LatencySnapshot is not thread safe.
+class LatencySnapshot
+{
+public:
+	/// Constructor
+	LatencySnapshot();
+
+	/// Add the counts of another snapshot into this snapshot.
+	/// @param[in] other - the snapshot to merge.
+	void Merge(const LatencySnapshot& other);
+
+	/// Get the value at the specified percentile.
+	/// @param[in] percentile - a percentile between 0.0 and 100.0.
+	/// @return The highest value equivalent to the bucket containing the
+	///		percentile, or 0 if no values were recorded.
+	std::uint64_t GetPercentile(double percentile) const;
+
+	/// Get the number of values recorded.
+	std::uint64_t GetCount() const { return m_count; }
+
+	/// Get the smallest value recorded, or 0 if none.
+	std::uint64_t GetMin() const { return m_count ? m_min : 0; }
+
+	/// Get the largest value recorded, or 0 if none.
+	std::uint64_t GetMax() const { return m_max; }
+
+	/// Get the arithmetic mean of all values recorded, or 0 if none.
+	double GetMean() const { return m_count ? double(m_sum) / double(m_count) : 0.0; }
+
+private:
+	friend class LatencyHistogram;
+
+	std::vector<std::uint64_t> m_counts;
+	std::uint64_t m_count;
+	std::uint64_t m_sum;
+	std::uint64_t m_min;
+	std::uint64_t m_max;
+};
+
+/// @brief A log-linear (HDR-style) histogram for recording latencies from many
+/// threads. Each power of two range is split into SUB_BUCKET_COUNT linear buckets
+/// giving a worst case relative error of 1 / SUB_BUCKET_COUNT.
+///
+/// @details Record() is lock-free and wait-free for counts. Each recording thread
+/// is assigned a shard so that threads do not share cache lines when the shard
+/// count is at least the number of recording threads. GetSnapshot() may be called
+/// from any thread at any time; values recorded concurrently may or may not be
+/// included. Values are unit-less, but nanoseconds is the convention used by the
+/// Record(std::chrono::nanoseconds) overload.
+class LatencyHistogram
+{
+public:
+	/// Number of linear sub-buckets per power of two (2 ^ SUB_BUCKET_BITS)
+	static const int SUB_BUCKET_BITS = 4;
+	static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+
+	/// Largest trackable value is 2 ^ MAX_VALUE_BITS - 1. Larger values are
+	/// saturated into the last bucket (~18 minutes in nanoseconds).
+	static const int MAX_VALUE_BITS = 40;
+
+	static const int BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+	/// Constructor
+	/// @param[in] shards - the number of per-thread shards.
+	explicit LatencyHistogram(int shards = 4);
+
+	~LatencyHistogram();
+
+	/// Record a value. Lock-free; safe to call from any thread.
+	/// @param[in] value - the value to record.
+	void Record(std::uint64_t value);
+
+	/// Record a duration in nanoseconds. Lock-free; safe to call from any thread.
+	/// @param[in] duration - the duration to record. Negative durations record as 0.
+	void Record(std::chrono::nanoseconds duration)
+	{
+		Record(duration.count() > 0 ? std::uint64_t(duration.count()) : 0);
+	}
+
+	/// Get a merged copy of all shards.
+	/// @return The histogram snapshot.
+	LatencySnapshot GetSnapshot() const;
+
+	/// Clear all recorded values. Values recorded concurrently may be lost.
+	void Reset();
+
+	/// Get the bucket index for a value.
+	static int GetBucketIndex(std::uint64_t value);
+
+	/// Get the highest value that maps to a bucket index.
+	static std::uint64_t GetBucketUpperBound(int index);
+
+private:
+	LatencyHistogram(const LatencyHistogram&) = delete;
+	LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+	/// Per-thread shard aligned to prevent false sharing between recording threads.
+	struct alignas(64) Shard
+	{
+		std::atomic<std::uint64_t> counts[BUCKET_COUNT];
+		std::atomic<std::uint64_t> sum;
+		std::atomic<std::uint64_t> min;
+		std::atomic<std::uint64_t> max;
+	};
+
+	/// Get the shard assigned to the calling thread.
+	Shard& GetShard();
+
+	const int m_shardCount;
+	std::unique_ptr<Shard[]> m_shards;
+};
+
+#endif
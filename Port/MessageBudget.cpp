@@ -0,0 +1,144 @@
+#include "MessageBudget.h"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+// MessageBudget
+//----------------------------------------------------------------------------
+MessageBudget::MessageBudget(MessageBudget* parent) :
+	m_parent(parent),
+	m_bytes(0),
+	m_maxBytes(0),
+	m_messages(0),
+	m_blocked(0),
+	m_dropped(0),
+	m_limit(0),
+	m_policy(BLOCK),
+	m_waiters(0)
+{
+}
+
+//----------------------------------------------------------------------------
+// GetGlobal
+//----------------------------------------------------------------------------
+MessageBudget& MessageBudget::GetGlobal()
+{
+	// Never destroyed, since static worker threads may release messages after
+	// static destruction has begun
+	static MessageBudget* global = new MessageBudget();
+	return *global;
+}
+
+//----------------------------------------------------------------------------
+// SetLimit
+//----------------------------------------------------------------------------
+void MessageBudget::SetLimit(size_t bytes, Policy policy)
+{
+	m_policy.store(policy);
+	m_limit.store(bytes);
+
+	// Waiters re-check against the new limit
+	lock_guard<mutex> lock(m_lock);
+	m_cv.notify_all();
+}
+
+//----------------------------------------------------------------------------
+// Acquire
+//----------------------------------------------------------------------------
+bool MessageBudget::Acquire(size_t bytes, bool sheddable, bool mayBlock)
+{
+	if (!Charge(bytes, sheddable, mayBlock))
+		return false;
+
+	if (m_parent && !m_parent->Acquire(bytes, sheddable, mayBlock))
+	{
+		Discharge(bytes);
+		return false;
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------
+// Release
+//----------------------------------------------------------------------------
+void MessageBudget::Release(size_t bytes)
+{
+	Discharge(bytes);
+	if (m_parent)
+		m_parent->Release(bytes);
+}
+
+//----------------------------------------------------------------------------
+// Charge
+//----------------------------------------------------------------------------
+bool MessageBudget::Charge(size_t bytes, bool sheddable, bool mayBlock)
+{
+	size_t held = m_bytes.fetch_add(bytes) + bytes;
+	size_t limit = m_limit.load(memory_order_relaxed);
+
+	// Over the limit, unless this is the only message held
+	if (limit != 0 && held > limit && held != bytes)
+	{
+		if (m_policy.load(memory_order_relaxed) == DROP)
+		{
+			if (sheddable)
+			{
+				Discharge(bytes);
+				m_dropped.fetch_add(1, memory_order_relaxed);
+				return false;
+			}
+		}
+		else if (mayBlock)
+		{
+			Discharge(bytes);
+			m_blocked.fetch_add(1, memory_order_relaxed);
+
+			unique_lock<mutex> lk(m_lock);
+			m_waiters++;
+			m_cv.wait(lk, [this, bytes] {
+				size_t current = m_bytes.load();
+				size_t currentLimit = m_limit.load();
+				return currentLimit == 0 || current == 0 || current + bytes <= currentLimit ||
+					m_policy.load() == DROP;
+			});
+			m_waiters--;
+			held = m_bytes.fetch_add(bytes) + bytes;
+		}
+	}
+
+	m_messages.fetch_add(1, memory_order_relaxed);
+	size_t maxBytes = m_maxBytes.load(memory_order_relaxed);
+	while (held > maxBytes && !m_maxBytes.compare_exchange_weak(maxBytes, held, memory_order_relaxed))
+		;
+	return true;
+}
+
+//----------------------------------------------------------------------------
+// Discharge
+//----------------------------------------------------------------------------
+void MessageBudget::Discharge(size_t bytes)
+{
+	m_bytes.fetch_sub(bytes);
+
+	// A waiter registers before checking the bytes held, so either it sees this
+	// release or this release sees the waiter
+	if (m_waiters.load() != 0)
+	{
+		lock_guard<mutex> lock(m_lock);
+		m_cv.notify_all();
+	}
+}
+
+//----------------------------------------------------------------------------
+// GetStats
+//----------------------------------------------------------------------------
+MessageBudget::Stats MessageBudget::GetStats() const
+{
+	Stats stats;
+	stats.bytes = m_bytes.load(memory_order_relaxed);
+	stats.maxBytes = m_maxBytes.load(memory_order_relaxed);
+	stats.messages = m_messages.load(memory_order_relaxed);
+	stats.blocked = m_blocked.load(memory_order_relaxed);
+	stats.dropped = m_dropped.load(memory_order_relaxed);
+	return stats;
+}
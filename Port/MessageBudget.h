@@ -0,0 +1,115 @@
+#ifndef _MESSAGE_BUDGET_H
+#define _MESSAGE_BUDGET_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/// @brief Accounts the bytes held by queued asynchronous messages and enforces
+/// an optional limit.
+///
+/// @details Each WorkerThread owns a budget charged with the size of every
+/// delegate message queued to it, including the argument copies, and released
+/// when the queued message is destroyed: once invoked, or when a message still
+/// queued at thread exit is discarded. Each thread budget is also charged to
+/// the global budget, so a limit can cap one thread or the whole process.
+///
+/// Accounting is one atomic addition and one subtraction per message on each
+/// budget, so it can stay enabled. Once a limit is set, a message that would
+/// exceed it is handled by the budget's policy:
+///
+/// * BLOCK - backpressure. The dispatching thread waits until enough queued
+///   messages are invoked. A worker waiting for room does not process its own
+///   queue, so avoid BLOCK where workers dispatch to each other in a cycle.
+/// * DROP - load shedding. The message is discarded, counted and notified
+///   with DelegateMsg::OnDiscarded().
+///
+/// Messages a source thread waits on, such as AsyncWait calls, are neither
+/// blocked nor discarded; they are accepted over the limit so the caller's
+/// own timeout still holds.
+///
+/// A message a worker dispatches to itself is neither blocked nor discarded;
+/// it is accepted over the limit, since it is typically a continuation the
+/// worker relies on.
+///
+/// A message is always accepted into an empty budget, so one message larger
+/// than the limit cannot block forever. The limit is soft: concurrent
+/// producers may overshoot it by at most one message each.
+class MessageBudget
+{
+public:
+	enum Policy { BLOCK, DROP };
+
+	/// Statistics of a budget.
+	struct Stats
+	{
+		/// Bytes currently held by queued messages, and the most ever held.
+		size_t bytes;
+		size_t maxBytes;
+
+		/// Messages charged since startup.
+		uint64_t messages;
+
+		/// Dispatches that waited for room, and messages discarded.
+		uint64_t blocked;
+		uint64_t dropped;
+	};
+
+	/// Constructor
+	/// @param[in] parent - the budget also charged with each message, or NULL.
+	explicit MessageBudget(MessageBudget* parent = NULL);
+
+	/// Set the limit and the policy applied once it is exceeded. May be called
+	/// from any thread at any time.
+	/// @param[in] bytes - the limit in bytes, or 0 for no limit.
+	/// @param[in] policy - BLOCK to wait for room, or DROP to discard.
+	void SetLimit(size_t bytes, Policy policy);
+
+	/// Charge a message being queued.
+	/// @param[in] bytes - the message size.
+	/// @param[in] sheddable - FALSE if the message must not be discarded.
+	/// @param[in] mayBlock - FALSE if the caller must not wait, e.g. it is the
+	///		thread that releases the budget, or a caller waits on the message.
+	/// @return TRUE if the message is accepted. FALSE if it must be discarded.
+	bool Acquire(size_t bytes, bool sheddable, bool mayBlock);
+
+	/// Release a message charged by Acquire().
+	/// @param[in] bytes - the message size.
+	void Release(size_t bytes);
+
+	/// Get the budget statistics. May be called from any thread.
+	Stats GetStats() const;
+
+	/// Get the budget charged with every WorkerThread message.
+	static MessageBudget& GetGlobal();
+
+private:
+	MessageBudget(const MessageBudget&) = delete;
+	MessageBudget& operator=(const MessageBudget&) = delete;
+
+	/// Charge this budget only.
+	bool Charge(size_t bytes, bool sheddable, bool mayBlock);
+
+	/// Release this budget only.
+	void Discharge(size_t bytes);
+
+	MessageBudget* const m_parent;
+
+	std::atomic<size_t> m_bytes;
+	std::atomic<size_t> m_maxBytes;
+	std::atomic<uint64_t> m_messages;
+	std::atomic<uint64_t> m_blocked;
+	std::atomic<uint64_t> m_dropped;
+
+	std::atomic<size_t> m_limit;
+	std::atomic<Policy> m_policy;
+
+	/// Blocked producers wait on the condition variable
+	std::mutex m_lock;
+	std::condition_variable m_cv;
+	std::atomic<unsigned> m_waiters;
+};
+
+#endif
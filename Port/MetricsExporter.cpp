@@ -0,0 +1,348 @@
+#include "MetricsExporter.h"
+#include "WorkerThreadStd.h"
+#include "Timer.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#if !defined(WIN32)
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+/// @brief Layout of the shared memory segment.
+struct MetricsExporter::Segment
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t size;
+	uint32_t reserved;
+
+	/// Odd while the exporter is writing data
+	std::atomic<uint64_t> sequence;
+
+	MetricsData data;
+};
+
+//----------------------------------------------------------------------------
+// MetricsExporter
+//----------------------------------------------------------------------------
+MetricsExporter::MetricsExporter() :
+	m_exit(false),
+	m_period(1000),
+	m_segment(nullptr),
+	m_data(new MetricsData()),
+	m_lastTime(chrono::steady_clock::now())
+{
+}
+
+//----------------------------------------------------------------------------
+// ~MetricsExporter
+//----------------------------------------------------------------------------
+MetricsExporter::~MetricsExporter()
+{
+	Stop();
+}
+
+//----------------------------------------------------------------------------
+// Start
+//----------------------------------------------------------------------------
+bool MetricsExporter::Start(const string& shmName, chrono::milliseconds period, const string& textFile)
+{
+	if (m_thread)
+		return true;
+
+	// Snapshot() callers see either the old settings or the new ones
+	lock_guard<mutex> lock(m_snapshotLock);
+	m_period = period.count() > 0 ? period : chrono::milliseconds(1);
+	m_shmName = shmName;
+	m_textFile = textFile;
+
+	if (!m_shmName.empty())
+	{
+#if defined(WIN32)
+		return false;
+#else
+		int fd = shm_open(m_shmName.c_str(), O_CREAT | O_RDWR, 0644);
+		if (fd < 0)
+			return false;
+		if (ftruncate(fd, sizeof(Segment)) != 0)
+		{
+			close(fd);
+			shm_unlink(m_shmName.c_str());
+			return false;
+		}
+		void* base = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		close(fd);
+		if (base == MAP_FAILED)
+		{
+			shm_unlink(m_shmName.c_str());
+			return false;
+		}
+
+		// The header is written last so a reader never accepts a partial segment
+		m_segment = new(base) Segment();
+		m_segment->sequence.store(0, memory_order_relaxed);
+		m_segment->size = sizeof(Segment);
+		m_segment->version = METRICS_VERSION;
+		atomic_thread_fence(memory_order_release);
+		m_segment->magic = METRICS_MAGIC;
+#endif
+	}
+
+	m_exit = false;
+	m_lastTime = chrono::steady_clock::now();
+	m_thread = std::unique_ptr<std::thread>(new thread(&MetricsExporter::Process, this));
+	return true;
+}
+
+//----------------------------------------------------------------------------
+// Stop
+//----------------------------------------------------------------------------
+void MetricsExporter::Stop()
+{
+	if (!m_thread)
+		return;
+
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_exit = true;
+		m_cv.notify_one();
+	}
+
+	m_thread->join();
+	m_thread = nullptr;
+
+#if !defined(WIN32)
+	lock_guard<mutex> lock(m_snapshotLock);
+	if (m_segment)
+	{
+		munmap(m_segment, sizeof(Segment));
+		shm_unlink(m_shmName.c_str());
+		m_segment = nullptr;
+	}
+#endif
+}
+
+//----------------------------------------------------------------------------
+// Snapshot
+//----------------------------------------------------------------------------
+MetricsData MetricsExporter::Snapshot()
+{
+	lock_guard<mutex> lock(m_snapshotLock);
+	Collect();
+	return *m_data;
+}
+
+//----------------------------------------------------------------------------
+// Collect
+//----------------------------------------------------------------------------
+void MetricsExporter::Collect()
+{
+	auto now = chrono::steady_clock::now();
+	double seconds = chrono::duration<double>(now - m_lastTime).count();
+	m_lastTime = now;
+
+	MetricsData& data = *m_data;
+	data.timeNs = uint64_t(chrono::duration_cast<chrono::nanoseconds>(
+		chrono::system_clock::now().time_since_epoch()).count());
+	data.snapshot++;
+	data.periodMs = uint64_t(m_period.count());
+	data.timers = Timer::GetTimerCount();
+	data.timerExpirations = Timer::GetExpiredCount();
+
+	// Sample every running worker
+	data.threadCount = 0;
+	unordered_map<const WorkerThread*, uint64_t> invokes;
+	WorkerThread::ForEachWorker([&](WorkerThread& worker) {
+		WorkerThread::InvokeStats stats = worker.GetInvokeStats();
+		invokes[&worker] = stats.invokes;
+		if (data.threadCount >= MetricsData::MAX_THREADS)
+			return;
+
+		// A worker not seen at the previous snapshot counts from zero
+		auto last = m_lastInvokes.find(&worker);
+		uint64_t lastInvokes = (last != m_lastInvokes.end() && last->second <= stats.invokes) ? last->second : 0;
+
+		MetricsThread& thread = data.threads[data.threadCount++];
+		snprintf(thread.name, sizeof(thread.name), "%s", worker.GetThreadName().c_str());
+		thread.queueDepth = worker.GetQueueSize();
+		thread.invokes = stats.invokes;
+		thread.invokesPerSec = seconds > 0 ? double(stats.invokes - lastInvokes) / seconds : 0.0;
+		thread.meanInvokeNs = stats.invokes ? stats.totalNs / stats.invokes : 0;
+		thread.maxInvokeNs = stats.maxNs;
+	});
+	m_lastInvokes.swap(invokes);
+
+	// Collect counters from the registered sources
+	vector<MetricsCounter> counters;
+	CounterCallback(counters);
+	data.counterCount = uint32_t(min<size_t>(counters.size(), MetricsData::MAX_COUNTERS));
+	for (uint32_t i = 0; i < data.counterCount; i++)
+	{
+		snprintf(data.counters[i].name, sizeof(data.counters[i].name), "%s", counters[i].name.c_str());
+		data.counters[i].value = counters[i].value;
+	}
+
+	Publish();
+	WriteTextFile();
+}
+
+//----------------------------------------------------------------------------
+// Publish
+//----------------------------------------------------------------------------
+void MetricsExporter::Publish()
+{
+	if (!m_segment)
+		return;
+
+	// Single writer; an odd sequence tells readers a write is in progress
+	uint64_t sequence = m_segment->sequence.load(memory_order_relaxed);
+	m_segment->sequence.store(sequence + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	memcpy(&m_segment->data, m_data.get(), sizeof(MetricsData));
+	m_segment->sequence.store(sequence + 2, memory_order_release);
+}
+
+//----------------------------------------------------------------------------
+// WriteTextFile
+//----------------------------------------------------------------------------
+void MetricsExporter::WriteTextFile()
+{
+	if (m_textFile.empty())
+		return;
+
+	// Write a temporary file and rename so a reader never sees a partial file
+	string tempFile = m_textFile + ".tmp";
+	FILE* fp = fopen(tempFile.c_str(), "w");
+	if (!fp)
+		return;
+	string text = Format(*m_data);
+	bool written = fwrite(text.data(), 1, text.size(), fp) == text.size();
+	if (fclose(fp) != 0 || !written)
+	{
+		remove(tempFile.c_str());
+		return;
+	}
+	rename(tempFile.c_str(), m_textFile.c_str());
+}
+
+//----------------------------------------------------------------------------
+// Read
+//----------------------------------------------------------------------------
+bool MetricsExporter::Read(const string& shmName, MetricsData& data)
+{
+#if defined(WIN32)
+	return false;
+#else
+	int fd = shm_open(shmName.c_str(), O_RDONLY, 0);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(Segment))
+	{
+		close(fd);
+		return false;
+	}
+	void* base = mmap(nullptr, sizeof(Segment), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED)
+		return false;
+
+	const Segment* segment = static_cast<const Segment*>(base);
+	bool success = false;
+	if (segment->magic == METRICS_MAGIC && segment->version == METRICS_VERSION && segment->size == sizeof(Segment))
+	{
+		atomic_thread_fence(memory_order_acquire);
+
+		// Retry while the exporter is writing. The bound guards against an
+		// exporter that died mid-write.
+		for (int retry = 0; retry < 1000 && !success; retry++)
+		{
+			uint64_t sequence = segment->sequence.load(memory_order_acquire);
+			if (sequence == 0)
+				break;		// Nothing published yet
+			if (sequence & 1)
+			{
+				this_thread::yield();
+				continue;
+			}
+			memcpy(&data, &segment->data, sizeof(MetricsData));
+			atomic_thread_fence(memory_order_acquire);
+			success = segment->sequence.load(memory_order_relaxed) == sequence;
+		}
+	}
+
+	munmap(base, sizeof(Segment));
+	return success;
+#endif
+}
+
+//----------------------------------------------------------------------------
+// Format
+//----------------------------------------------------------------------------
+string MetricsExporter::Format(const MetricsData& data)
+{
+	string text;
+	char line[256];
+	snprintf(line, sizeof(line), "Snapshot %llu  Period %llu ms  Timers %llu  Timer expirations %llu\n",
+		(unsigned long long)data.snapshot, (unsigned long long)data.periodMs,
+		(unsigned long long)data.timers, (unsigned long long)data.timerExpirations);
+	text += line;
+
+	snprintf(line, sizeof(line), "%-24s %8s %12s %12s %12s %12s\n",
+		"Thread", "Queued", "Invokes", "Invokes/s", "Mean ns", "Max ns");
+	text += line;
+	for (uint32_t i = 0; i < data.threadCount && i < MetricsData::MAX_THREADS; i++)
+	{
+		const MetricsThread& thread = data.threads[i];
+		snprintf(line, sizeof(line), "%-24.*s %8llu %12llu %12.1f %12llu %12llu\n",
+			int(sizeof(thread.name)), thread.name,
+			(unsigned long long)thread.queueDepth,
+			(unsigned long long)thread.invokes,
+			thread.invokesPerSec,
+			(unsigned long long)thread.meanInvokeNs,
+			(unsigned long long)thread.maxInvokeNs);
+		text += line;
+	}
+
+	if (data.counterCount > 0)
+	{
+		snprintf(line, sizeof(line), "%-56s %12s\n", "Counter", "Value");
+		text += line;
+	}
+	for (uint32_t i = 0; i < data.counterCount && i < MetricsData::MAX_COUNTERS; i++)
+	{
+		const MetricsValue& counter = data.counters[i];
+		snprintf(line, sizeof(line), "%-56.*s %12llu\n",
+			int(sizeof(counter.name)), counter.name, (unsigned long long)counter.value);
+		text += line;
+	}
+	return text;
+}
+
+//----------------------------------------------------------------------------
+// Process
+//----------------------------------------------------------------------------
+void MetricsExporter::Process()
+{
+	Tracer::SetThreadName("MetricsExporter");
+
+	while (1)
+	{
+		{
+			lock_guard<mutex> lock(m_snapshotLock);
+			Collect();
+		}
+
+		unique_lock<mutex> lk(m_mutex);
+		if (m_cv.wait_for(lk, m_period, [this] { return m_exit; }))
+			return;
+	}
+}
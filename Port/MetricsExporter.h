@@ -0,0 +1,181 @@
+#ifndef _METRICS_EXPORTER_H
+#define _METRICS_EXPORTER_H
+
+#include "MulticastDelegateSafe.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class WorkerThread;
+
+/// @brief A named value exported with each metrics snapshot, e.g. a per-state
+/// count. Supplied by MetricsExporter::CounterCallback handlers.
+struct MetricsCounter
+{
+	std::string name;
+	uint64_t value;
+};
+
+/// @brief Metrics of one worker thread within a snapshot.
+struct MetricsThread
+{
+	char name[32];
+
+	/// Messages queued when the snapshot was taken.
+	uint64_t queueDepth;
+
+	/// Invocations completed since the thread started.
+	uint64_t invokes;
+
+	/// Invocations completed per second since the previous snapshot.
+	double invokesPerSec;
+
+	/// Mean and longest invocation time in nanoseconds.
+	uint64_t meanInvokeNs;
+	uint64_t maxInvokeNs;
+};
+
+/// @brief A named counter within a snapshot.
+struct MetricsValue
+{
+	char name[56];
+	uint64_t value;
+};
+
+/// @brief One metrics snapshot. Plain data with a fixed layout so other
+/// processes can read it; any layout change increments METRICS_VERSION.
+struct MetricsData
+{
+	static const uint32_t MAX_THREADS = 32;
+	static const uint32_t MAX_COUNTERS = 64;
+
+	/// System clock time the snapshot was taken in nanoseconds since the epoch.
+	uint64_t timeNs;
+
+	/// Snapshots published since the exporter started.
+	uint64_t snapshot;
+
+	/// The export period in milliseconds.
+	uint64_t periodMs;
+
+	/// Enabled timers and timer expirations since startup.
+	uint64_t timers;
+	uint64_t timerExpirations;
+
+	uint32_t threadCount;
+	uint32_t counterCount;
+	MetricsThread threads[MAX_THREADS];
+	MetricsValue counters[MAX_COUNTERS];
+};
+
+/// @brief Periodically exports runtime metrics for external monitoring.
+///
+/// @details A background thread samples every running WorkerThread (queue
+/// depth, invocation rate and duration), the timer counts and any counters
+/// supplied by CounterCallback handlers, such as the StateProfiler per-state
+/// counts. Each snapshot is published into a POSIX shared memory segment that
+/// any process may map read-only, and optionally rewritten to a text file.
+///
+/// The segment holds a versioned header and one MetricsData block protected by
+/// a sequence lock: the exporter makes the sequence odd, writes the block and
+/// makes it even again. A reader copies the block and retries if the sequence
+/// was odd or changed, so neither side ever blocks the other. Collecting a
+/// snapshot only reads atomics already maintained by the workers; the hot
+/// paths are not touched.
+///
+/// Shared memory is only supported on POSIX systems; elsewhere snapshots are
+/// exported to the text file only.
+class MetricsExporter
+{
+public:
+	static const uint32_t METRICS_MAGIC = 0x3158544D;		// "MTX1"
+	static const uint32_t METRICS_VERSION = 1;
+
+	/// Constructor
+	MetricsExporter();
+
+	/// Destructor
+	~MetricsExporter();
+
+	/// Called once to create the shared memory segment and exporter thread.
+	/// @param[in] shmName - the shared memory segment name, e.g. "/delegate_metrics".
+	///		Empty to export to the text file only.
+	/// @param[in] period - the time between snapshots.
+	/// @param[in] textFile - the file rewritten with each snapshot. Empty for none.
+	/// @return TRUE if the thread is created. FALSE otherwise.
+	bool Start(const std::string& shmName, std::chrono::milliseconds period = std::chrono::milliseconds(1000),
+		const std::string& textFile = "");
+
+	/// Exit the exporter thread and remove the shared memory segment.
+	void Stop();
+
+	/// Collect and publish one snapshot now, in addition to the periodic ones.
+	/// Takes turns with the exporter thread, so the published block is never
+	/// written by two threads at once.
+	/// @return A copy of the snapshot published.
+	MetricsData Snapshot();
+
+	/// Read the latest snapshot from a shared memory segment. Lock-free.
+	/// @param[in] shmName - the shared memory segment name.
+	/// @param[out] data - the snapshot.
+	/// @return TRUE if a consistent snapshot was read.
+	static bool Read(const std::string& shmName, MetricsData& data);
+
+	/// Format a snapshot as printable text.
+	/// @param[in] data - the snapshot.
+	/// @return A printable table.
+	static std::string Format(const MetricsData& data);
+
+	/// Invoked on the exporter thread for each snapshot. Handlers append named
+	/// counters to the vector; counters beyond MetricsData::MAX_COUNTERS are
+	/// dropped.
+	DelegateLib::MulticastDelegateSafe<void(std::vector<MetricsCounter>&)> CounterCallback;
+
+private:
+	MetricsExporter(const MetricsExporter&) = delete;
+	MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+	struct Segment;
+
+	/// Entry point for the exporter thread
+	void Process();
+
+	/// Collect a snapshot into m_data and publish it. Called with
+	/// m_snapshotLock held.
+	void Collect();
+
+	/// Publish m_data into the shared memory segment
+	void Publish();
+
+	/// Rewrite the text file with m_data
+	void WriteTextFile();
+
+	std::unique_ptr<std::thread> m_thread;
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	bool m_exit;
+	std::chrono::milliseconds m_period;
+	std::string m_shmName;
+	std::string m_textFile;
+	Segment* m_segment;
+
+	/// Serializes snapshots taken by the exporter thread and by Snapshot() callers
+	std::mutex m_snapshotLock;
+
+	/// The snapshot being built. Guarded by m_snapshotLock.
+	std::unique_ptr<MetricsData> m_data;
+
+	/// Invocations per worker and the time at the previous snapshot. Guarded by
+	/// m_snapshotLock.
+	std::unordered_map<const WorkerThread*, uint64_t> m_lastInvokes;
+	std::chrono::steady_clock::time_point m_lastTime;
+};
+
+#endif
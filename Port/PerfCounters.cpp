@@ -0,0 +1,150 @@
+#include "PerfCounters.h"
+
+#if defined(__linux__)
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+	#include <string.h>
+#endif
+
+using namespace std;
+
+#if defined(__linux__)
+//------------------------------------------------------------------------------
+// OpenCounter
+//------------------------------------------------------------------------------
+static int OpenCounter(uint32_t type, uint64_t config)
+{
+	perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.disabled = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+	// Count the calling thread on any CPU. Try including kernel events first,
+	// then fall back to user space only for restrictive perf_event_paranoid levels.
+	int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+	if (fd < 0)
+	{
+		attr.exclude_kernel = 1;
+		fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+	}
+	return fd;
+}
+#endif
+
+//------------------------------------------------------------------------------
+// PerfCounters
+//------------------------------------------------------------------------------
+PerfCounters::PerfCounters()
+{
+	for (int i = 0; i < COUNTER_MAX; i++)
+		m_fd[i] = -1;
+
+#if defined(__linux__)
+	m_fd[CYCLES] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+	m_fd[INSTRUCTIONS] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+	m_fd[CACHE_MISSES] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+	m_fd[BRANCH_MISSES] = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+	m_fd[CONTEXT_SWITCHES] = OpenCounter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES);
+#endif
+}
+
+//------------------------------------------------------------------------------
+// ~PerfCounters
+//------------------------------------------------------------------------------
+PerfCounters::~PerfCounters()
+{
+#if defined(__linux__)
+	for (int i = 0; i < COUNTER_MAX; i++)
+	{
+		if (m_fd[i] >= 0)
+			close(m_fd[i]);
+	}
+#endif
+}
+
+//------------------------------------------------------------------------------
+// IsAnyAvailable
+//------------------------------------------------------------------------------
+bool PerfCounters::IsAnyAvailable() const
+{
+	for (int i = 0; i < COUNTER_MAX; i++)
+	{
+		if (m_fd[i] >= 0)
+			return true;
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------------
+// Start
+//------------------------------------------------------------------------------
+void PerfCounters::Start()
+{
+#if defined(__linux__)
+	for (int i = 0; i < COUNTER_MAX; i++)
+	{
+		if (m_fd[i] < 0)
+			continue;
+		ioctl(m_fd[i], PERF_EVENT_IOC_RESET, 0);
+		ioctl(m_fd[i], PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Stop
+//------------------------------------------------------------------------------
+PerfCounters::Sample PerfCounters::Stop()
+{
+	Sample sample;
+
+#if defined(__linux__)
+	for (int i = 0; i < COUNTER_MAX; i++)
+	{
+		if (m_fd[i] >= 0)
+			ioctl(m_fd[i], PERF_EVENT_IOC_DISABLE, 0);
+	}
+
+	for (int i = 0; i < COUNTER_MAX; i++)
+	{
+		if (m_fd[i] < 0)
+			continue;
+
+		// value, time enabled, time running
+		uint64_t data[3] = { 0, 0, 0 };
+		if (read(m_fd[i], data, sizeof(data)) != (ssize_t)sizeof(data))
+			continue;
+
+		// Scale up if the kernel multiplexed this counter with others
+		if (data[2] != 0 && data[2] < data[1])
+			data[0] = (uint64_t)((double)data[0] * (double)data[1] / (double)data[2]);
+
+		sample.value[i] = data[0];
+		sample.valid[i] = data[2] != 0 || data[1] == 0;
+	}
+#endif
+
+	return sample;
+}
+
+//------------------------------------------------------------------------------
+// GetName
+//------------------------------------------------------------------------------
+const char* PerfCounters::GetName(Counter counter)
+{
+	switch (counter)
+	{
+		case CYCLES:			return "cycles";
+		case INSTRUCTIONS:		return "instructions";
+		case CACHE_MISSES:		return "cache-misses";
+		case BRANCH_MISSES:		return "branch-misses";
+		case CONTEXT_SWITCHES:	return "context-switches";
+		default:				return "unknown";
+	}
+}
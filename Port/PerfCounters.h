@@ -0,0 +1,77 @@
+#ifndef _PERF_COUNTERS_H
+#define _PERF_COUNTERS_H
+
+#include <cstdint>
+
+/// @brief Hardware and software performance counters for measuring a code region
+/// on the calling thread. Uses `perf_event_open()` on Linux. On other platforms, or
+/// when the kernel denies access (see /proc/sys/kernel/perf_event_paranoid), the
+/// unavailable counters are reported as not valid and the region still runs.
+///
+/// @details A PerfCounters instance must be created, started and stopped on the
+/// same thread. Only events on that thread are counted; work performed by other
+/// threads on its behalf (e.g. a delegate target invoked on a WorkerThread) is not.
+class PerfCounters
+{
+public:
+	enum Counter
+	{
+		CYCLES,
+		INSTRUCTIONS,
+		CACHE_MISSES,
+		BRANCH_MISSES,
+		CONTEXT_SWITCHES,
+		COUNTER_MAX
+	};
+
+	/// @brief Counter values captured between Start() and Stop().
+	struct Sample
+	{
+		std::uint64_t value[COUNTER_MAX] = {};
+		bool valid[COUNTER_MAX] = {};
+
+		/// Get a counter value divided by an operation count.
+		/// @param[in] counter - the counter.
+		/// @param[in] ops - the number of operations measured.
+		/// @return The counter per operation, or -1.0 if the counter is not valid.
+		double PerOp(Counter counter, std::uint64_t ops) const
+		{
+			if (!valid[counter] || ops == 0)
+				return -1.0;
+			return double(value[counter]) / double(ops);
+		}
+	};
+
+	/// Constructor. Opens all counters for the calling thread.
+	PerfCounters();
+
+	/// Destructor. Closes all counters.
+	~PerfCounters();
+
+	/// Get whether a counter could be opened.
+	/// @param[in] counter - the counter.
+	/// @return TRUE if the counter is available.
+	bool IsAvailable(Counter counter) const { return m_fd[counter] >= 0; }
+
+	/// Get whether any counter could be opened.
+	bool IsAnyAvailable() const;
+
+	/// Reset and start counting.
+	void Start();
+
+	/// Stop counting and read the counters. Counters multiplexed by the kernel
+	/// are scaled to the full measurement time.
+	/// @return The counter values since Start().
+	Sample Stop();
+
+	/// Get a short printable counter name.
+	static const char* GetName(Counter counter);
+
+private:
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator=(const PerfCounters&) = delete;
+
+	int m_fd[COUNTER_MAX];
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "StallWatchdog.h"
+#include "WorkerThreadStd.h"
+#include "Tracer.h"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+// StallWatchdog
+//----------------------------------------------------------------------------
+StallWatchdog::StallWatchdog() :
+	m_exit(false),
+	m_threshold(100),
+	m_scanPeriod(25),
+	m_stallCount(0)
+{
+}
+
+//----------------------------------------------------------------------------
+// ~StallWatchdog
+//----------------------------------------------------------------------------
+StallWatchdog::~StallWatchdog()
+{
+	Stop();
+}
+
+//----------------------------------------------------------------------------
+// Start
+//----------------------------------------------------------------------------
+bool StallWatchdog::Start(chrono::milliseconds threshold, chrono::milliseconds scanPeriod)
+{
+	if (m_thread)
+		return true;
+
+	m_threshold = threshold;
+	m_scanPeriod = scanPeriod.count() > 0 ? scanPeriod : threshold / 4;
+	if (m_scanPeriod.count() <= 0)
+		m_scanPeriod = chrono::milliseconds(1);
+
+	m_exit = false;
+	m_thread = std::unique_ptr<std::thread>(new thread(&StallWatchdog::Process, this));
+	return true;
+}
+
+//----------------------------------------------------------------------------
+// Stop
+//----------------------------------------------------------------------------
+void StallWatchdog::Stop()
+{
+	if (!m_thread)
+		return;
+
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_exit = true;
+		m_cv.notify_one();
+	}
+
+	m_thread->join();
+	m_thread = nullptr;
+}
+
+//----------------------------------------------------------------------------
+// Scan
+//----------------------------------------------------------------------------
+vector<StallReport> StallWatchdog::Scan()
+{
+	uint64_t now = uint64_t(chrono::duration_cast<chrono::nanoseconds>(
+		chrono::steady_clock::now().time_since_epoch()).count());
+	uint64_t thresholdNs = uint64_t(chrono::duration_cast<chrono::nanoseconds>(m_threshold).count());
+
+	// Serialize with the watchdog thread. Only the workers still stalled are
+	// carried to the next scan, so an exited worker's entry is dropped and a new
+	// worker at the same address starts clean.
+	lock_guard<mutex> lock(m_mutex);
+	unordered_map<const WorkerThread*, uint64_t> reported;
+
+	vector<StallReport> stalls;
+	WorkerThread::ForEachWorker([&](WorkerThread& worker) {
+		uint64_t startNs;
+		const char* target;
+		if (!worker.GetInvocation(startNs, target) || now < startNs || now - startNs < thresholdNs)
+			return;
+
+		// Report each stalled invocation once
+		reported[&worker] = startNs;
+		auto last = m_reported.find(&worker);
+		if (last != m_reported.end() && last->second == startNs)
+			return;
+
+		StallReport report;
+		report.threadName = worker.GetThreadName();
+		report.target = Tracer::GetTypeName(target);
+		report.durationNs = now - startNs;
+		report.queueSize = worker.GetQueueSize();
+		stalls.push_back(report);
+	});
+	m_reported.swap(reported);
+
+	m_stallCount += stalls.size();
+	return stalls;
+}
+
+//----------------------------------------------------------------------------
+// Process
+//----------------------------------------------------------------------------
+void StallWatchdog::Process()
+{
+	Tracer::SetThreadName("StallWatchdog");
+
+	while (1)
+	{
+		{
+			unique_lock<mutex> lk(m_mutex);
+			if (m_cv.wait_for(lk, m_scanPeriod, [this] { return m_exit; }))
+				return;
+		}
+
+		for (const StallReport& report : Scan())
+			StallCallback(report);
+	}
+}
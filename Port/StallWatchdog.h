@@ -0,0 +1,91 @@
+#ifndef _STALL_WATCHDOG_H
+#define _STALL_WATCHDOG_H
+
+#include "MulticastDelegateSafe.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class WorkerThread;
+
+/// @brief A stalled invocation found by StallWatchdog.
+struct StallReport
+{
+	/// The worker thread name.
+	std::string threadName;
+
+	/// The invoked target type name.
+	std::string target;
+
+	/// Time the invocation has been running in nanoseconds.
+	uint64_t durationNs;
+
+	/// Messages queued behind the invocation.
+	size_t queueSize;
+};
+
+/// @brief Detects long running invocations on worker threads.
+///
+/// @details Each WorkerThread publishes the start time and target of the
+/// invocation it is running in a lock-free slot; publishing costs a clock read
+/// and a few atomic stores per message. The watchdog thread periodically scans
+/// every running worker and reports each invocation running longer than the
+/// threshold once, along with the worker's queue depth so the backed up queue
+/// is identified.
+class StallWatchdog
+{
+public:
+	/// Constructor
+	StallWatchdog();
+
+	/// Destructor
+	~StallWatchdog();
+
+	/// Called once to create the watchdog thread
+	/// @param[in] threshold - report invocations running at least this long.
+	/// @param[in] scanPeriod - the time between scans. 0 uses a quarter of the threshold.
+	/// @return TRUE if the thread is created. FALSE otherwise.
+	bool Start(std::chrono::milliseconds threshold, std::chrono::milliseconds scanPeriod = std::chrono::milliseconds(0));
+
+	/// Exit the watchdog thread
+	void Stop();
+
+	/// Scan all workers once. Called by the watchdog thread. A direct call is
+	/// serialized with the thread's scans, so a stall is still reported once.
+	/// @return The invocations newly found running longer than the threshold.
+	std::vector<StallReport> Scan();
+
+	/// Get the number of stalls reported.
+	uint64_t GetStallCount() const { return m_stallCount; }
+
+	/// Invoked on the watchdog thread for each stall found.
+	DelegateLib::MulticastDelegateSafe<void(const StallReport&)> StallCallback;
+
+private:
+	StallWatchdog(const StallWatchdog&) = delete;
+	StallWatchdog& operator=(const StallWatchdog&) = delete;
+
+	/// Entry point for the watchdog thread
+	void Process();
+
+	std::unique_ptr<std::thread> m_thread;
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	bool m_exit;
+	std::chrono::milliseconds m_threshold;
+	std::chrono::milliseconds m_scanPeriod;
+	std::atomic<uint64_t> m_stallCount;
+
+	/// Start time of the invocation reported per worker still stalled at the
+	/// last scan, so each stall is reported once. Guarded by m_mutex.
+	std::unordered_map<const WorkerThread*, uint64_t> m_reported;
+};
+
+#endif
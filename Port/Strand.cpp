@@ -0,0 +1,120 @@
+#include "Strand.h"
+#include "ThreadPool.h"
+#include "Fault.h"
+#include "Tracer.h"
+#include <thread>
+#include <typeinfo>
+
+using namespace std;
+using namespace DelegateLib;
+
+/// The strand being run by the calling pool worker, if any.
+static thread_local const Strand* currentStrand = nullptr;
+
+/// @brief A dispatched message within the strand list.
+struct Strand::Node
+{
+	Node* next;
+	std::shared_ptr<DelegateMsg> msg;
+};
+
+//----------------------------------------------------------------------------
+// ~Strand
+//----------------------------------------------------------------------------
+Strand::~Strand()
+{
+	// A strand cannot destroy itself from one of its own messages
+	ASSERT_TRUE(!IsCurrent());
+
+	// The pool must never run a destroyed strand. Wait for a running strand to
+	// finish, and take a queued strand back off the pool queue.
+	while (m_pending.load(memory_order_acquire) != 0 && !m_pool.Unschedule(this))
+		this_thread::yield();
+
+	Node* node = m_head.exchange(nullptr);
+	while (node != nullptr)
+	{
+		Node* next = node->next;
+		delete node;
+		node = next;
+	}
+}
+
+//----------------------------------------------------------------------------
+// IsCurrent
+//----------------------------------------------------------------------------
+bool Strand::IsCurrent() const
+{
+	return currentStrand == this;
+}
+
+//----------------------------------------------------------------------------
+// DispatchDelegate
+//----------------------------------------------------------------------------
+void Strand::DispatchDelegate(std::shared_ptr<DelegateLib::DelegateMsg> msg)
+{
+	Node* node = new Node{ nullptr, msg };
+
+	// Trace the dispatch like WorkerThread; the invoke is traced within Run()
+	TraceSpan span("DispatchDelegate", "delegate");
+
+	// Raise m_pending before pushing, so Run() never takes more nodes than the
+	// count it subtracts. Only the dispatch that finds the strand idle, the 0 to
+	// 1 transition, schedules it.
+	bool schedule = m_pending.fetch_add(1, memory_order_acq_rel) == 0;
+
+	Node* head = m_head.load(memory_order_relaxed);
+	do
+	{
+		node->next = head;
+	} while (!m_head.compare_exchange_weak(head, node, memory_order_release, memory_order_relaxed));
+
+	if (schedule)
+		m_pool.Schedule(this);
+}
+
+//----------------------------------------------------------------------------
+// Run
+//----------------------------------------------------------------------------
+void Strand::Run()
+{
+	currentStrand = this;
+
+	// Take every message dispatched so far and restore dispatch order
+	Node* node = m_head.exchange(nullptr, memory_order_acquire);
+	Node* ordered = nullptr;
+	while (node != nullptr)
+	{
+		Node* next = node->next;
+		node->next = ordered;
+		ordered = node;
+		node = next;
+	}
+
+	uint32_t count = 0;
+	while (ordered != nullptr)
+	{
+		auto invoker = ordered->msg->GetDelegateInvoker();
+		ASSERT_TRUE(invoker);
+		{
+			TraceSpan span(Tracer::IsEnabled() ? typeid(*invoker).name() : "", "delegate", true);
+
+			// Invoke the delegate destination target function
+			bool success = invoker->Invoke(ordered->msg);
+			ASSERT_TRUE(success);
+		}
+
+		Node* next = ordered->next;
+		delete ordered;
+		ordered = next;
+		count++;
+	}
+
+	currentStrand = nullptr;
+
+	// Messages dispatched during the run, or counted but not yet pushed, keep
+	// the strand scheduled. Requeue rather than loop so other strands get a turn.
+	// Once the count reaches zero this run no longer touches the strand.
+	if (m_pending.fetch_sub(count, memory_order_acq_rel) != count)
+		m_pool.Schedule(this);
+}
@@ -0,0 +1,64 @@
+#ifndef _STRAND_H
+#define _STRAND_H
+
+#include "DelegateThread.h"
+#include <atomic>
+#include <cstdint>
+
+class ThreadPool;
+
+/// @brief A serialized execution context on a shared ThreadPool. 
+///
+/// @details Messages dispatched to a strand are invoked in order and never
+/// concurrently, but on whichever pool worker is free. A strand can be used
+/// anywhere a WorkerThread is used as a delegate target thread, so many state
+/// machines can each own a strand while sharing a few threads.
+///
+/// Dispatch pushes onto a lock-free list and, only when the strand was idle,
+/// queues the strand on its pool. An idle strand holds no pool resources; its
+/// size is a vtable pointer, a pool pointer, a list head and a counter.
+class Strand : public DelegateLib::DelegateThread
+{
+public:
+	/// Constructor
+	/// @param[in] pool - the pool that executes this strand. Must outlive the strand.
+	Strand(ThreadPool& pool) : m_pool(pool), m_head(nullptr), m_pending(0) {}
+
+	/// Destructor. Waits for a run in progress on a pool worker to finish, then
+	/// discards any messages not yet invoked. Must not be called from a message
+	/// invoked on this strand.
+	~Strand();
+
+	/// Get whether the calling thread is currently executing this strand.
+	/// @return TRUE if called from a message invoked on this strand.
+	bool IsCurrent() const;
+
+	/// Get the number of messages dispatched but not yet invoked.
+	std::uint32_t GetQueueSize() const { return m_pending.load(std::memory_order_relaxed); }
+
+	virtual void DispatchDelegate(std::shared_ptr<DelegateLib::DelegateMsg> msg);
+
+private:
+	Strand(const Strand&) = delete;
+	Strand& operator=(const Strand&) = delete;
+
+	friend class ThreadPool;
+
+	struct Node;
+
+	/// Invoke the pending messages. Called by a pool worker.
+	void Run();
+
+	ThreadPool& m_pool;
+
+	/// Most recently dispatched message; a LIFO list reversed by Run().
+	std::atomic<Node*> m_head;
+
+	/// Messages dispatched but not yet invoked, raised before each push. The
+	/// dispatch that raises the count from zero schedules the strand; a run that
+	/// leaves it non-zero schedules it again. The strand is therefore queued or
+	/// running at most once.
+	std::atomic<std::uint32_t> m_pending;
+};
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef _THREAD_MSG_H
 #define _THREAD_MSG_H
 
+#include "MessageBudget.h"
+#include <cstdint>
+
 /// @brief A class to hold a platform-specific thread messsage that will be passed 
 /// through the OS message queue. 
 class ThreadMsg
@@ -19,12 +22,44 @@ public:
 	{
 	}
 
+	/// Destructor. Releases the memory budget charge, whether or not the message
+	/// was processed.
+	~ThreadMsg()
+	{
+		if (m_budget)
+			m_budget->Release(m_charged);
+	}
+
 	int GetId() const { return m_id; } 
     std::shared_ptr<DelegateLib::DelegateMsg> GetData() { return m_data; }
 
+	/// Get the Tracer flow identifier linking dispatch to invoke, or 0 if none.
+	std::uint64_t GetTraceId() const { return m_traceId; }
+	void SetTraceId(std::uint64_t traceId) { m_traceId = traceId; }
+
+	/// Get the time the message was queued in nanoseconds, or 0 if not recorded.
+	std::uint64_t GetQueueTime() const { return m_queueTime; }
+	void SetQueueTime(std::uint64_t queueTime) { m_queueTime = queueTime; }
+
+	/// Hold a memory budget charge until the message is destroyed.
+	/// @param[in] budget - the budget charged. Must outlive the message.
+	/// @param[in] bytes - the bytes charged.
+	void SetBudgetCharge(MessageBudget* budget, size_t bytes)
+	{
+		m_budget = budget;
+		m_charged = bytes;
+	}
+
 private:
+	ThreadMsg(const ThreadMsg&) = delete;
+	ThreadMsg& operator=(const ThreadMsg&) = delete;
+
 	int m_id;
     std::shared_ptr<DelegateLib::DelegateMsg> m_data;
+	std::uint64_t m_traceId = 0;
+	std::uint64_t m_queueTime = 0;
+	MessageBudget* m_budget = nullptr;
+	size_t m_charged = 0;
 };
 
 #endif
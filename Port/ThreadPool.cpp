@@ -0,0 +1,117 @@
+#include "ThreadPool.h"
+#include "Strand.h"
+#include "Tracer.h"
+#include <algorithm>
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+// ThreadPool
+//----------------------------------------------------------------------------
+ThreadPool::ThreadPool(const std::string& poolName) : m_exit(false), POOL_NAME(poolName)
+{
+}
+
+//----------------------------------------------------------------------------
+// ~ThreadPool
+//----------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+	ExitThreads();
+}
+
+//----------------------------------------------------------------------------
+// CreateThreads
+//----------------------------------------------------------------------------
+bool ThreadPool::CreateThreads(unsigned threadCount)
+{
+	if (!m_threads.empty())
+		return true;
+
+	if (threadCount == 0)
+		threadCount = thread::hardware_concurrency() > 0 ? thread::hardware_concurrency() : 1;
+
+	m_exit = false;
+	for (unsigned i = 0; i < threadCount; i++)
+		m_threads.push_back(std::unique_ptr<std::thread>(new thread(&ThreadPool::Process, this, i)));
+	return true;
+}
+
+//----------------------------------------------------------------------------
+// ExitThreads
+//----------------------------------------------------------------------------
+void ThreadPool::ExitThreads()
+{
+	if (m_threads.empty())
+		return;
+
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_exit = true;
+		m_cv.notify_all();
+	}
+
+	for (auto& thread : m_threads)
+		thread->join();
+	m_threads.clear();
+}
+
+//----------------------------------------------------------------------------
+// GetQueueSize
+//----------------------------------------------------------------------------
+size_t ThreadPool::GetQueueSize()
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_queue.size();
+}
+
+//----------------------------------------------------------------------------
+// Schedule
+//----------------------------------------------------------------------------
+void ThreadPool::Schedule(Strand* strand)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_queue.push_back(strand);
+	m_cv.notify_one();
+}
+
+//----------------------------------------------------------------------------
+// Unschedule
+//----------------------------------------------------------------------------
+bool ThreadPool::Unschedule(Strand* strand)
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = std::find(m_queue.begin(), m_queue.end(), strand);
+	if (it == m_queue.end())
+		return false;
+	m_queue.erase(it);
+	return true;
+}
+
+//----------------------------------------------------------------------------
+// Process
+//----------------------------------------------------------------------------
+void ThreadPool::Process(unsigned index)
+{
+	Tracer::SetThreadName(POOL_NAME + "-" + to_string(index));
+
+	while (1)
+	{
+		Strand* strand;
+		{
+			// Wait for a strand with pending messages
+			unique_lock<mutex> lk(m_mutex);
+			while (m_queue.empty() && !m_exit)
+				m_cv.wait(lk);
+
+			// Exit once all pending strands have run
+			if (m_queue.empty())
+				return;
+
+			strand = m_queue.front();
+			m_queue.pop_front();
+		}
+
+		strand->Run();
+	}
+}
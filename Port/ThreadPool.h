@@ -0,0 +1,71 @@
+#ifndef _THREAD_POOL_H
+#define _THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Strand;
+
+/// @brief A fixed set of worker threads that execute Strand instances. 
+///
+/// @details The pool queue only holds strands that have pending messages. A 
+/// worker takes the next strand, runs the messages it has, and moves on; a 
+/// strand with more messages waiting goes to the back of the queue so that a
+/// busy strand does not starve the others.
+class ThreadPool
+{
+public:
+	/// Constructor
+	/// @param[in] poolName - the pool name. Workers are named "poolName-N".
+	ThreadPool(const std::string& poolName);
+
+	/// Destructor
+	~ThreadPool();
+
+	/// Called once to create the worker threads
+	/// @param[in] threadCount - the number of workers; 0 uses the hardware concurrency.
+	/// @return TRUE if threads are created. FALSE otherwise.
+	bool CreateThreads(unsigned threadCount = 0);
+
+	/// Called once at program exit. Runs all pending strands then exits the workers.
+	void ExitThreads();
+
+	/// Get the number of worker threads.
+	size_t GetThreadCount() const { return m_threads.size(); }
+
+	/// Get the number of strands waiting for a worker.
+	size_t GetQueueSize();
+
+	/// Get pool name
+	std::string GetPoolName() { return POOL_NAME; }
+
+private:
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	friend class Strand;
+
+	/// Queue a strand with pending messages. Called by Strand only.
+	void Schedule(Strand* strand);
+
+	/// Remove a queued strand. Called by the Strand destructor only.
+	/// @return TRUE if the strand was queued. FALSE if not, e.g. it is running.
+	bool Unschedule(Strand* strand);
+
+	/// Entry point for each worker thread
+	void Process(unsigned index);
+
+	std::vector<std::unique_ptr<std::thread>> m_threads;
+	std::deque<Strand*> m_queue;
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	bool m_exit;
+	const std::string POOL_NAME;
+};
+
+#endif
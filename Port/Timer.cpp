@@ -7,6 +7,9 @@ using namespace std;
 std::mutex Timer::m_lock;
 bool Timer::m_timerStopped = false;
 xlist<Timer*> Timer::m_timers;
+std::atomic<uint64_t> Timer::m_expiredCount(0);
+std::atomic<bool> Timer::m_armed(false);
+std::atomic<void (*)(void)> Timer::m_armedHandler(nullptr);
 
 //------------------------------------------------------------------------------
 // TimerDisabled
@@ -42,17 +45,27 @@ void Timer::Start(std::chrono::milliseconds timeout)
 	if (timeout <= std::chrono::milliseconds(0))
 		throw std::invalid_argument("Timeout cannot be 0");
 
-	const std::lock_guard<std::mutex> lock(m_lock);
+	{
+		const std::lock_guard<std::mutex> lock(m_lock);
 
-	m_timeout = timeout;
-	m_expireTime = GetTime();
-	m_enabled = true;
+		m_timeout = timeout;
+		m_expireTime = GetTime();
+		m_enabled = true;
 
-	// Remove the existing entry, if any, to prevent duplicates in the list
-	m_timers.remove(this);
+		// Remove the existing entry, if any, to prevent duplicates in the list
+		m_timers.remove(this);
 
-	// Add this timer to the list for servicing
-	m_timers.push_back(this);
+		// Add this timer to the list for servicing
+		m_timers.push_back(this);
+	}
+
+	// Start timer servicing on the first timer, outside the lock
+	if (!m_armed.exchange(true))
+	{
+		void (*handler)(void) = m_armedHandler.load();
+		if (handler)
+			handler();
+	}
 }
 
 //------------------------------------------------------------------------------
@@ -88,6 +101,8 @@ void Timer::CheckExpired()
 		m_expireTime = GetTime();
 	}
 
+	m_expiredCount.fetch_add(1, std::memory_order_relaxed);
+
 	// Call the client's expired callback function
 	if (Expired)
 		Expired();
@@ -124,6 +139,22 @@ void Timer::ProcessTimers()
 	}
 }
 
+//------------------------------------------------------------------------------
+// GetTimerCount
+//------------------------------------------------------------------------------
+size_t Timer::GetTimerCount()
+{
+	const std::lock_guard<std::mutex> lock(m_lock);
+
+	size_t count = 0;
+	for (TimersIterator it = m_timers.begin(); it != m_timers.end(); it++)
+	{
+		if ((*it) != NULL && (*it)->Enabled())
+			count++;
+	}
+	return count;
+}
+
 std::chrono::milliseconds Timer::GetTime()
 {
 	auto duration = std::chrono::system_clock::now().time_since_epoch();
@@ -2,6 +2,8 @@
 #define _TIMER_H
 
 #include "DelegateLib.h"
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <list>
 
@@ -46,6 +48,22 @@ public:
 	/// Called on a periodic basic to service all timer instances. 
 	static void ProcessTimers();
 
+	/// Get the number of enabled timers.
+	static size_t GetTimerCount();
+
+	/// Get the number of timer expirations since startup.
+	static uint64_t GetExpiredCount() { return m_expiredCount.load(std::memory_order_relaxed); }
+
+	/// Get whether any timer has been started.
+	/// @return TRUE once the first timer is started.
+	static bool IsArmed() { return m_armed.load(); }
+
+	/// Set the function called when the first timer is started, so the timer 
+	/// servicing thread need not run until a timer exists. Called at most once, 
+	/// on the thread calling Start(). 
+	/// @param[in] handler - the function, or NULL for none.
+	static void SetArmedHandler(void (*handler)(void)) { m_armedHandler.store(handler); }
+
 private:
 	// Prevent inadvertent copying of this object
 	Timer(const Timer&);
@@ -65,6 +83,13 @@ private:
 	std::chrono::milliseconds m_expireTime = std::chrono::milliseconds(0);
 	bool m_enabled = false;
 	static bool m_timerStopped;
+
+	/// Expired callbacks made by all timers.
+	static std::atomic<uint64_t> m_expiredCount;
+
+	/// Set when the first timer is started.
+	static std::atomic<bool> m_armed;
+	static std::atomic<void (*)(void)> m_armedHandler;
 };
 
 #endif
@@ -0,0 +1,269 @@
+#include "Tracer.h"
+#include <chrono>
+#include <cstdio>
+#include <cctype>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#if defined(__GNUG__)
+	#include <cxxabi.h>
+#endif
+
+using namespace std;
+
+std::atomic<bool> Tracer::m_enabled(false);
+std::atomic<std::uint64_t> Tracer::m_nextFlowId(1);
+std::atomic<std::uint64_t> Tracer::m_dropped(0);
+
+/// Maximum events buffered per thread between flushes
+static const size_t MAX_THREAD_EVENTS = 1 << 20;
+
+/// A single trace event as recorded on the hot path
+struct TraceEvent
+{
+	const char* name;
+	const char* category;
+	const char* machine;
+	uint64_t ts;
+	uint64_t dur;
+	uint64_t id;
+	int state;
+	char phase;
+	bool isTypeName;
+};
+
+/// Events recorded by one thread
+struct ThreadBuffer
+{
+	mutex lock;
+	vector<TraceEvent> events;
+	string name;
+	int tid = 0;
+};
+
+//------------------------------------------------------------------------------
+// GetBuffers
+//------------------------------------------------------------------------------
+static vector<shared_ptr<ThreadBuffer>>& GetBuffers(mutex*& lock)
+{
+	// Buffers outlive their threads so events can be flushed after thread exit
+	static mutex buffersLock;
+	static vector<shared_ptr<ThreadBuffer>> buffers;
+	lock = &buffersLock;
+	return buffers;
+}
+
+//------------------------------------------------------------------------------
+// GetThreadBuffer
+//------------------------------------------------------------------------------
+static ThreadBuffer& GetThreadBuffer()
+{
+	thread_local shared_ptr<ThreadBuffer> buffer;
+	if (!buffer)
+	{
+		buffer = make_shared<ThreadBuffer>();
+
+		mutex* lock;
+		auto& buffers = GetBuffers(lock);
+		lock_guard<mutex> guard(*lock);
+		buffer->tid = int(buffers.size()) + 1;
+		buffers.push_back(buffer);
+	}
+	return *buffer;
+}
+
+//------------------------------------------------------------------------------
+// AddEvent
+//------------------------------------------------------------------------------
+static void AddEvent(const TraceEvent& event, atomic<uint64_t>& dropped)
+{
+	ThreadBuffer& buffer = GetThreadBuffer();
+	lock_guard<mutex> guard(buffer.lock);
+	if (buffer.events.size() >= MAX_THREAD_EVENTS)
+	{
+		dropped.fetch_add(1, memory_order_relaxed);
+		return;
+	}
+	buffer.events.push_back(event);
+}
+
+//------------------------------------------------------------------------------
+// GetTime
+//------------------------------------------------------------------------------
+uint64_t Tracer::GetTime()
+{
+	static const auto epoch = chrono::steady_clock::now();
+	return uint64_t(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - epoch).count());
+}
+
+//------------------------------------------------------------------------------
+// SetThreadName
+//------------------------------------------------------------------------------
+void Tracer::SetThreadName(const std::string& name)
+{
+	ThreadBuffer& buffer = GetThreadBuffer();
+	lock_guard<mutex> guard(buffer.lock);
+	buffer.name = name;
+}
+
+//------------------------------------------------------------------------------
+// Complete
+//------------------------------------------------------------------------------
+void Tracer::Complete(const char* name, const char* category, bool isTypeName,
+	uint64_t startNs, const char* machine, int state)
+{
+	uint64_t now = GetTime();
+	TraceEvent event = { name, category, machine, startNs, now - startNs, 0, state, 'X', isTypeName };
+	AddEvent(event, m_dropped);
+}
+
+//------------------------------------------------------------------------------
+// FlowBegin
+//------------------------------------------------------------------------------
+void Tracer::FlowBegin(uint64_t id)
+{
+	TraceEvent event = { "DispatchDelegate", "delegate", nullptr, GetTime(), 0, id, -1, 's', false };
+	AddEvent(event, m_dropped);
+}
+
+//------------------------------------------------------------------------------
+// FlowEnd
+//------------------------------------------------------------------------------
+void Tracer::FlowEnd(uint64_t id)
+{
+	TraceEvent event = { "DispatchDelegate", "delegate", nullptr, GetTime(), 0, id, -1, 'f', false };
+	AddEvent(event, m_dropped);
+}
+
+//------------------------------------------------------------------------------
+// Demangle
+//------------------------------------------------------------------------------
+static string Demangle(const char* name)
+{
+#if defined(__GNUG__)
+	int status = 0;
+	char* demangled = abi::__cxa_demangle(name, NULL, NULL, &status);
+	if (status == 0 && demangled != NULL)
+	{
+		string result(demangled);
+		free(demangled);
+		return result;
+	}
+#endif
+	return name;
+}
+
+//------------------------------------------------------------------------------
+// GetTypeName
+//------------------------------------------------------------------------------
+string Tracer::GetTypeName(const char* name)
+{
+	string type = Demangle(name);
+
+	// State, guard, entry and exit classes are named by their member function
+	// pointer template argument e.g. "&CentrifugeTest::ST_Idle". Reference
+	// argument types such as "void (SelfTestStatus const&)" are skipped.
+	for (size_t amp = type.rfind('&'); amp != string::npos && amp > 0; amp = type.rfind('&', amp - 1))
+	{
+		char next = amp + 1 < type.size() ? type[amp + 1] : '\0';
+		if (next != '_' && !isalpha((unsigned char)next))
+			continue;
+
+		size_t end = type.find_first_of(",>", amp);
+		return type.substr(amp + 1, end == string::npos ? string::npos : end - amp - 1);
+	}
+	return type;
+}
+
+//------------------------------------------------------------------------------
+// Escape
+//------------------------------------------------------------------------------
+static string Escape(const string& str)
+{
+	string result;
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+			result += '\\';
+		if ((unsigned char)c >= 0x20)
+			result += c;
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------------
+// Flush
+//------------------------------------------------------------------------------
+bool Tracer::Flush(const std::string& fileName)
+{
+	FILE* file = fopen(fileName.c_str(), "w");
+	if (file == NULL)
+		return false;
+
+	// Snapshot the list of thread buffers
+	mutex* lock;
+	vector<shared_ptr<ThreadBuffer>> buffers;
+	{
+		auto& all = GetBuffers(lock);
+		lock_guard<mutex> guard(*lock);
+		buffers = all;
+	}
+
+	// Type names are demangled once per unique string
+	map<const char*, string> names;
+	auto lookup = [&names](const char* name, bool isTypeName) -> const string& {
+		auto it = names.find(name);
+		if (it == names.end())
+			it = names.emplace(name, Escape(isTypeName ? GetTypeName(name) : string(name))).first;
+		return it->second;
+	};
+
+	fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+	bool first = true;
+	for (auto& buffer : buffers)
+	{
+		vector<TraceEvent> events;
+		string threadName;
+		{
+			lock_guard<mutex> guard(buffer->lock);
+			events.swap(buffer->events);
+			threadName = buffer->name;
+		}
+
+		if (!threadName.empty())
+		{
+			fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+				first ? "" : ",\n", buffer->tid, Escape(threadName).c_str());
+			first = false;
+		}
+
+		for (const TraceEvent& e : events)
+		{
+			fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d",
+				first ? "" : ",\n", lookup(e.name, e.isTypeName).c_str(), e.category, e.phase,
+				double(e.ts) / 1000.0, buffer->tid);
+			first = false;
+
+			if (e.phase == 'X')
+				fprintf(file, ",\"dur\":%.3f", double(e.dur) / 1000.0);
+			else
+				fprintf(file, ",\"id\":%llu%s", (unsigned long long)e.id, e.phase == 'f' ? ",\"bp\":\"e\"" : "");
+
+			if (e.machine != NULL || e.state >= 0)
+			{
+				fprintf(file, ",\"args\":{");
+				if (e.machine != NULL)
+					fprintf(file, "\"machine\":\"%s\"%s", lookup(e.machine, true).c_str(), e.state >= 0 ? "," : "");
+				if (e.state >= 0)
+					fprintf(file, "\"state\":%d", e.state);
+				fprintf(file, "}");
+			}
+			fprintf(file, "}");
+		}
+	}
+	fprintf(file, "\n]}\n");
+
+	return fclose(file) == 0;
+}
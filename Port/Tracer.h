@@ -0,0 +1,108 @@
+#ifndef _TRACER_H
+#define _TRACER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/// @brief Records trace events into per-thread buffers and writes them as a
+/// Chrome trace-event JSON file viewable in chrome://tracing or ui.perfetto.dev.
+///
+/// @details Tracing is disabled by default. When disabled each trace point costs
+/// a single relaxed atomic load. When enabled, events are appended to a buffer
+/// owned by the calling thread; the buffer lock is only ever contended by Flush().
+///
+/// Event names are static strings. A name may instead be a `typeid().name()`
+/// string, in which case it is demangled and shortened during Flush() so that
+/// `StateAction<CentrifugeTest, NoEventData, &CentrifugeTest::ST_Idle>` is
+/// shown as `CentrifugeTest::ST_Idle`.
+class Tracer
+{
+public:
+	/// Enable or disable event recording.
+	static void Enable(bool enable) { m_enabled.store(enable, std::memory_order_relaxed); }
+
+	/// Get whether event recording is enabled.
+	static bool IsEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+	/// Name the calling thread within the trace.
+	/// @param[in] name - the thread name.
+	static void SetThreadName(const std::string& name);
+
+	/// Record a complete duration event ("X" phase) on the calling thread.
+	/// @param[in] name - the static event name or typeid name.
+	/// @param[in] category - the static category name.
+	/// @param[in] isTypeName - TRUE if name is a `typeid().name()` string.
+	/// @param[in] startNs - the start time from GetTime().
+	/// @param[in] machine - an optional "machine" argument holding a `typeid().name()`.
+	/// @param[in] state - an optional "state" argument; ignored if negative.
+	static void Complete(const char* name, const char* category, bool isTypeName,
+		std::uint64_t startNs, const char* machine = nullptr, int state = -1);
+
+	/// Get a new unique flow identifier used to link events across threads.
+	static std::uint64_t NewFlowId() { return m_nextFlowId.fetch_add(1, std::memory_order_relaxed); }
+
+	/// Record the start of a flow on the calling thread. Call within a span.
+	/// @param[in] id - the flow identifier from NewFlowId().
+	static void FlowBegin(std::uint64_t id);
+
+	/// Record the end of a flow on the calling thread. Call within a span.
+	/// @param[in] id - the flow identifier passed to FlowBegin().
+	static void FlowEnd(std::uint64_t id);
+
+	/// Get the trace time in nanoseconds.
+	static std::uint64_t GetTime();
+
+	/// Write all buffered events to a JSON trace file and clear the buffers.
+	/// @param[in] fileName - the output file name.
+	/// @return TRUE if the file was written.
+	static bool Flush(const std::string& fileName);
+
+	/// Get the demangled, shortened display name of a `typeid().name()` string,
+	/// as used for trace event names.
+	/// @param[in] name - the typeid name.
+	/// @return The display name e.g. "CentrifugeTest::ST_Idle".
+	static std::string GetTypeName(const char* name);
+
+	/// Get the number of events discarded because a thread buffer was full.
+	static std::uint64_t GetDroppedCount() { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+	static std::atomic<bool> m_enabled;
+	static std::atomic<std::uint64_t> m_nextFlowId;
+	static std::atomic<std::uint64_t> m_dropped;
+};
+
+/// @brief RAII helper recording a complete event spanning its lifetime. Does
+/// nothing if tracing was disabled at construction or name is NULL.
+class TraceSpan
+{
+public:
+	TraceSpan(const char* name, const char* category, bool isTypeName = false,
+		const char* machine = nullptr, int state = -1) :
+		m_name(name), m_category(category), m_machine(machine), m_state(state),
+		m_isTypeName(isTypeName), m_enabled(name != nullptr && Tracer::IsEnabled()),
+		m_start(m_enabled ? Tracer::GetTime() : 0)
+	{
+	}
+
+	~TraceSpan()
+	{
+		if (m_enabled)
+			Tracer::Complete(m_name, m_category, m_isTypeName, m_start, m_machine, m_state);
+	}
+
+private:
+	TraceSpan(const TraceSpan&) = delete;
+	TraceSpan& operator=(const TraceSpan&) = delete;
+
+	const char* m_name;
+	const char* m_category;
+	const char* m_machine;
+	int m_state;
+	bool m_isTypeName;
+	bool m_enabled;
+	std::uint64_t m_start;
+};
+
+#endif
@@ -0,0 +1,627 @@
+#include "TransitionJournal.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if !defined(WIN32)
+	#include <dirent.h>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+static const uint32_t SEGMENT_MAGIC = 0x314A4D53;		// "SMJ1"
+static const uint32_t SNAPSHOT_MAGIC = 0x314E4D53;		// "SMN1"
+static const uint32_t JOURNAL_VERSION = 1;
+
+/// Header at the start of each segment file, followed by the records.
+struct SegmentHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t recordSize;
+	uint32_t capacity;
+	uint64_t number;
+	uint64_t reserved;
+};
+
+/// Header at the start of the snapshot file, followed by count entries.
+struct SnapshotHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t count;
+	uint32_t reserved;
+};
+
+struct SnapshotEntry
+{
+	uint32_t machineId;
+	uint32_t state;
+	uint64_t sequence;
+	uint64_t timeNs;
+};
+
+/// @brief A mapped segment file.
+struct TransitionJournal::Segment
+{
+	uint64_t number = 0;
+	string fileName;
+	int fd = -1;
+	size_t size = 0;
+	void* base = nullptr;
+	Record* records = nullptr;
+	uint32_t capacity = 0;
+
+	/// Slots claimed by Append(). May exceed capacity once the segment is full.
+	atomic<uint32_t> next{ 0 };
+
+	/// Slots completely written by Append().
+	atomic<uint32_t> written{ 0 };
+
+	/// Slots claimed as of the last flush. Only accessed by the flusher thread.
+	uint32_t flushed = 0;
+};
+
+//------------------------------------------------------------------------------
+// GetCheck
+//------------------------------------------------------------------------------
+static uint32_t GetCheck(const TransitionJournal::Record& record)
+{
+	return uint32_t(record.sequence) ^ uint32_t(record.sequence >> 32) ^
+		uint32_t(record.timeNs) ^ uint32_t(record.timeNs >> 32) ^ record.machineId ^
+		(uint32_t(record.fromState) << 8 | record.toState) ^ SEGMENT_MAGIC;
+}
+
+//------------------------------------------------------------------------------
+// GetSegmentFileName
+//------------------------------------------------------------------------------
+static string GetSegmentFileName(const string& name, uint64_t number)
+{
+	char suffix[32];
+	snprintf(suffix, sizeof(suffix), ".%06llu.seg", (unsigned long long)number);
+	return name + suffix;
+}
+
+//------------------------------------------------------------------------------
+// TransitionJournal
+//------------------------------------------------------------------------------
+TransitionJournal::TransitionJournal() :
+	m_recordsPerSegment(0),
+	m_flushInterval(0),
+	m_active(nullptr),
+	m_spare(nullptr),
+	m_nextSegment(1),
+	m_nextSequence(1),
+	m_appended(0),
+	m_dropped(0),
+	m_epoch(0),
+	m_stop(false)
+{
+	m_inFlight[0] = 0;
+	m_inFlight[1] = 0;
+	static_assert(sizeof(Record) == 32, "Record size changed");
+}
+
+//------------------------------------------------------------------------------
+// ~TransitionJournal
+//------------------------------------------------------------------------------
+TransitionJournal::~TransitionJournal()
+{
+	Close();
+}
+
+//------------------------------------------------------------------------------
+// Open
+//------------------------------------------------------------------------------
+BOOL TransitionJournal::Open(const string& name, uint32_t recordsPerSegment,
+	chrono::milliseconds flushInterval)
+{
+#if defined(WIN32)
+	return FALSE;
+#else
+	if (m_active.load() != nullptr)
+		return FALSE;
+
+	m_name = name;
+	m_recordsPerSegment = recordsPerSegment > 0 ? recordsPerSegment : 1;
+	m_flushInterval = flushInterval;
+	m_nextSegment = 1;
+	m_nextSequence = 1;
+	m_appended = 0;
+	m_dropped = 0;
+	m_snapshot.clear();
+
+	// Fold any segments from a previous run into the snapshot
+	if (!LoadSnapshot() || !Recover())
+		return FALSE;
+
+	Segment* segment = CreateSegment();
+	if (segment == nullptr)
+		return FALSE;
+
+	m_stop = false;
+	m_active.store(segment, memory_order_release);
+	m_flusher = thread(&TransitionJournal::Process, this);
+	return TRUE;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Close
+//------------------------------------------------------------------------------
+void TransitionJournal::Close()
+{
+	Segment* active = m_active.load();
+	if (active == nullptr)
+		return;
+
+	{
+		lock_guard<mutex> lock(m_lock);
+		m_stop = true;
+	}
+	m_cv.notify_all();
+	m_flusher.join();
+
+	m_active.store(nullptr);
+
+	// No appends remain in flight so every segment can be compacted
+	for (Segment* segment : m_sealed)
+		CompactSegment(segment);
+	m_sealed.clear();
+	CompactSegment(active);
+
+	if (m_spare != nullptr)
+	{
+		DestroySegment(m_spare, true);
+		m_spare = nullptr;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Append
+//------------------------------------------------------------------------------
+BOOL TransitionJournal::Append(UINT32 machineId, BYTE fromState, BYTE toState)
+{
+	// Count this append as in flight before loading the active segment, so the
+	// flusher does not destroy a segment this append may still touch. If the
+	// epoch advanced before the count was visible, WaitForAppenders() may not
+	// wait for it, so back out and retry against the new epoch.
+	uint32_t slot;
+	while (1)
+	{
+		uint32_t epoch = m_epoch.load();
+		slot = epoch & 1;
+		m_inFlight[slot].fetch_add(1);
+		if (m_epoch.load() == epoch)
+			break;
+		m_inFlight[slot].fetch_sub(1);
+	}
+
+	BOOL success = FALSE;
+	Segment* segment = m_active.load();
+	while (segment != nullptr)
+	{
+		uint32_t index = segment->next.fetch_add(1, memory_order_relaxed);
+		if (index < segment->capacity)
+		{
+			Record& record = segment->records[index];
+			record.sequence = m_nextSequence.fetch_add(1, memory_order_relaxed);
+			record.timeNs = uint64_t(chrono::duration_cast<chrono::nanoseconds>(
+				chrono::system_clock::now().time_since_epoch()).count());
+			record.machineId = machineId;
+			record.fromState = fromState;
+			record.toState = toState;
+
+			// Write the check last so a partially written record is never valid
+			atomic_thread_fence(memory_order_release);
+			record.check = GetCheck(record);
+
+			segment->written.fetch_add(1, memory_order_release);
+			m_appended.fetch_add(1, memory_order_relaxed);
+			success = TRUE;
+			break;
+		}
+
+		// Segment full; switch to a new one and retry
+		if (!Rotate(segment))
+		{
+			m_dropped.fetch_add(1, memory_order_relaxed);
+			break;
+		}
+		segment = m_active.load();
+	}
+
+	m_inFlight[slot].fetch_sub(1);
+	return success;
+}
+
+//------------------------------------------------------------------------------
+// WaitForAppenders
+//------------------------------------------------------------------------------
+void TransitionJournal::WaitForAppenders()
+{
+	// Appends starting from now count in the other slot and load the current
+	// active segment, so only the appends counted in the old slot can still
+	// hold a segment sealed before this call. They finish without waiting on
+	// the flusher, so the old slot drains even under a steady append load.
+	uint32_t slot = m_epoch.fetch_add(1) & 1;
+	while (m_inFlight[slot].load() != 0)
+		this_thread::yield();
+}
+
+//------------------------------------------------------------------------------
+// Rotate
+//------------------------------------------------------------------------------
+BOOL TransitionJournal::Rotate(Segment* full)
+{
+	lock_guard<mutex> lock(m_lock);
+
+	// Another thread already rotated this segment?
+	if (m_active.load() != full)
+		return TRUE;
+
+	// Normally the flusher thread has a spare segment ready
+	Segment* next = m_spare;
+	m_spare = nullptr;
+	if (next == nullptr)
+		next = CreateSegment();
+	if (next == nullptr)
+		return FALSE;
+
+	m_sealed.push_back(full);
+	m_active.store(next);
+
+	// Wake the flusher to compact the full segment and create a new spare
+	m_cv.notify_one();
+	return TRUE;
+}
+
+//------------------------------------------------------------------------------
+// GetLatestState
+//------------------------------------------------------------------------------
+BOOL TransitionJournal::GetLatestState(UINT32 machineId, Snapshot& snapshot) const
+{
+	lock_guard<mutex> lock(m_snapshotLock);
+	auto it = m_snapshot.find(machineId);
+	if (it == m_snapshot.end())
+		return FALSE;
+	snapshot = it->second;
+	return TRUE;
+}
+
+//------------------------------------------------------------------------------
+// GetLatestStates
+//------------------------------------------------------------------------------
+map<UINT32, TransitionJournal::Snapshot> TransitionJournal::GetLatestStates() const
+{
+	lock_guard<mutex> lock(m_snapshotLock);
+	return m_snapshot;
+}
+
+//------------------------------------------------------------------------------
+// Process
+//------------------------------------------------------------------------------
+void TransitionJournal::Process()
+{
+	unique_lock<mutex> lock(m_lock);
+	while (!m_stop)
+	{
+		m_cv.wait_for(lock, m_flushInterval);
+		if (m_stop)
+			break;
+
+		// Keep a spare segment ready so rotation does not create a file
+		if (m_spare == nullptr)
+		{
+			lock.unlock();
+			Segment* spare = CreateSegment();
+			lock.lock();
+			if (m_spare == nullptr)
+				m_spare = spare;
+			else if (spare != nullptr)
+				DestroySegment(spare, true);
+		}
+
+		// Full segments are ready once every claimed slot has been written
+		vector<Segment*> ready;
+		for (auto it = m_sealed.begin(); it != m_sealed.end(); )
+		{
+			if ((*it)->written.load(memory_order_acquire) >= (*it)->capacity)
+			{
+				ready.push_back(*it);
+				it = m_sealed.erase(it);
+			}
+			else
+				++it;
+		}
+		Segment* active = m_active.load();
+
+		lock.unlock();
+		Flush(active);
+
+		// A late append may still be about to claim a slot past the end of a
+		// ready segment. Wait for it outside the lock, since Rotate() takes it.
+		if (!ready.empty())
+			WaitForAppenders();
+		for (Segment* segment : ready)
+			CompactSegment(segment);
+		lock.lock();
+	}
+}
+
+//------------------------------------------------------------------------------
+// Flush
+//------------------------------------------------------------------------------
+void TransitionJournal::Flush(Segment* segment)
+{
+#if !defined(WIN32)
+	uint32_t claimed = min(segment->next.load(memory_order_acquire), segment->capacity);
+	if (claimed == segment->flushed)
+		return;
+
+	// Sync from the page holding the first unflushed record. A record still being
+	// written is synced by the next flush or made durable by compaction.
+	size_t page = size_t(sysconf(_SC_PAGESIZE));
+	size_t start = sizeof(SegmentHeader) + size_t(segment->flushed) * sizeof(Record);
+	size_t end = sizeof(SegmentHeader) + size_t(claimed) * sizeof(Record);
+	start -= start % page;
+	msync(static_cast<char*>(segment->base) + start, end - start, MS_SYNC);
+	segment->flushed = claimed;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Compact
+//------------------------------------------------------------------------------
+void TransitionJournal::Compact(const Record* records, uint32_t count)
+{
+	lock_guard<mutex> lock(m_snapshotLock);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const Record& record = records[i];
+		if (record.check != GetCheck(record))
+			continue;
+
+		// Records within a segment are not strictly in sequence order
+		auto it = m_snapshot.find(record.machineId);
+		if (it == m_snapshot.end() || record.sequence > it->second.sequence)
+			m_snapshot[record.machineId] = { record.toState, record.sequence, record.timeNs };
+
+		if (record.sequence >= m_nextSequence.load(memory_order_relaxed))
+			m_nextSequence.store(record.sequence + 1, memory_order_relaxed);
+	}
+}
+
+//------------------------------------------------------------------------------
+// CompactSegment
+//------------------------------------------------------------------------------
+void TransitionJournal::CompactSegment(Segment* segment)
+{
+	Compact(segment->records, min(segment->next.load(memory_order_acquire), segment->capacity));
+
+	// The segment is only deleted once the snapshot holding its records is durable
+	DestroySegment(segment, SaveSnapshot() == TRUE);
+}
+
+//------------------------------------------------------------------------------
+// CreateSegment
+//------------------------------------------------------------------------------
+TransitionJournal::Segment* TransitionJournal::CreateSegment()
+{
+#if defined(WIN32)
+	return nullptr;
+#else
+	Segment* segment = new Segment();
+	segment->number = m_nextSegment.fetch_add(1, memory_order_relaxed);
+	segment->fileName = GetSegmentFileName(m_name, segment->number);
+	segment->capacity = m_recordsPerSegment;
+	segment->size = sizeof(SegmentHeader) + size_t(segment->capacity) * sizeof(Record);
+
+	segment->fd = open(segment->fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (segment->fd < 0)
+	{
+		delete segment;
+		return nullptr;
+	}
+
+	// Reserve the disk blocks up front; writing a sparse mapping on a full disk
+	// raises SIGBUS instead of returning an error
+	if (posix_fallocate(segment->fd, 0, off_t(segment->size)) != 0)
+	{
+		DestroySegment(segment, true);
+		return nullptr;
+	}
+
+	segment->base = mmap(nullptr, segment->size, PROT_READ | PROT_WRITE, MAP_SHARED, segment->fd, 0);
+	if (segment->base == MAP_FAILED)
+	{
+		segment->base = nullptr;
+		DestroySegment(segment, true);
+		return nullptr;
+	}
+
+	// Take the write fault of each page here, normally on the flusher thread,
+	// rather than on the first Append() to each page
+	size_t page = size_t(sysconf(_SC_PAGESIZE));
+	volatile char* bytes = static_cast<volatile char*>(segment->base);
+	for (size_t offset = 0; offset < segment->size; offset += page)
+		bytes[offset] = 0;
+
+	SegmentHeader* header = static_cast<SegmentHeader*>(segment->base);
+	header->magic = SEGMENT_MAGIC;
+	header->version = JOURNAL_VERSION;
+	header->recordSize = sizeof(Record);
+	header->capacity = segment->capacity;
+	header->number = segment->number;
+	header->reserved = 0;
+	segment->records = reinterpret_cast<Record*>(header + 1);
+	return segment;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// DestroySegment
+//------------------------------------------------------------------------------
+void TransitionJournal::DestroySegment(Segment* segment, bool remove)
+{
+#if !defined(WIN32)
+	if (segment->base != nullptr)
+		munmap(segment->base, segment->size);
+	if (segment->fd >= 0)
+		close(segment->fd);
+	if (remove)
+		unlink(segment->fileName.c_str());
+#endif
+	delete segment;
+}
+
+//------------------------------------------------------------------------------
+// Recover
+//------------------------------------------------------------------------------
+BOOL TransitionJournal::Recover()
+{
+#if defined(WIN32)
+	return FALSE;
+#else
+	size_t slash = m_name.find_last_of('/');
+	string dir = slash == string::npos ? "." : m_name.substr(0, slash + 1);
+	string prefix = (slash == string::npos ? m_name : m_name.substr(slash + 1)) + ".";
+
+	DIR* handle = opendir(dir.c_str());
+	if (handle == nullptr)
+		return FALSE;
+
+	// Find the segment numbers left by a previous run
+	vector<uint64_t> numbers;
+	while (dirent* entry = readdir(handle))
+	{
+		string file = entry->d_name;
+		if (file.size() > prefix.size() + 4 && file.compare(0, prefix.size(), prefix) == 0 &&
+			file.compare(file.size() - 4, 4, ".seg") == 0)
+		{
+			char* end = nullptr;
+			uint64_t number = strtoull(file.c_str() + prefix.size(), &end, 10);
+			if (end != nullptr && strcmp(end, ".seg") == 0)
+				numbers.push_back(number);
+		}
+	}
+	closedir(handle);
+	sort(numbers.begin(), numbers.end());
+
+	for (uint64_t number : numbers)
+	{
+		string fileName = GetSegmentFileName(m_name, number);
+		int fd = open(fileName.c_str(), O_RDONLY);
+		if (fd < 0)
+			continue;
+
+		struct stat status;
+		if (fstat(fd, &status) == 0 && size_t(status.st_size) >= sizeof(SegmentHeader))
+		{
+			size_t size = size_t(status.st_size);
+			void* base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (base != MAP_FAILED)
+			{
+				const SegmentHeader* header = static_cast<const SegmentHeader*>(base);
+				if (header->magic == SEGMENT_MAGIC && header->recordSize == sizeof(Record))
+				{
+					size_t count = min(size_t(header->capacity), (size - sizeof(SegmentHeader)) / sizeof(Record));
+					Compact(reinterpret_cast<const Record*>(header + 1), uint32_t(count));
+				}
+				munmap(base, size);
+			}
+		}
+		close(fd);
+
+		if (number >= m_nextSegment)
+			m_nextSegment = number + 1;
+	}
+
+	if (numbers.empty())
+		return TRUE;
+
+	// Delete the recovered segments only once the snapshot is durable
+	if (!SaveSnapshot())
+		return FALSE;
+	for (uint64_t number : numbers)
+		unlink(GetSegmentFileName(m_name, number).c_str());
+	return TRUE;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// LoadSnapshot
+//------------------------------------------------------------------------------
+BOOL TransitionJournal::LoadSnapshot()
+{
+	FILE* file = fopen((m_name + ".snapshot").c_str(), "rb");
+	if (file == nullptr)
+		return TRUE;	// No snapshot yet
+
+	BOOL success = FALSE;
+	SnapshotHeader header;
+	if (fread(&header, sizeof(header), 1, file) == 1 && header.magic == SNAPSHOT_MAGIC &&
+		header.version == JOURNAL_VERSION)
+	{
+		lock_guard<mutex> lock(m_snapshotLock);
+		success = TRUE;
+		for (uint32_t i = 0; i < header.count; i++)
+		{
+			SnapshotEntry entry;
+			if (fread(&entry, sizeof(entry), 1, file) != 1)
+			{
+				success = FALSE;
+				break;
+			}
+			m_snapshot[entry.machineId] = { BYTE(entry.state), entry.sequence, entry.timeNs };
+			if (entry.sequence >= m_nextSequence)
+				m_nextSequence = entry.sequence + 1;
+		}
+	}
+	fclose(file);
+	return success;
+}
+
+//------------------------------------------------------------------------------
+// SaveSnapshot
+//------------------------------------------------------------------------------
+BOOL TransitionJournal::SaveSnapshot()
+{
+#if defined(WIN32)
+	return FALSE;
+#else
+	// Write a temporary file then rename so a crash never leaves a partial snapshot
+	string fileName = m_name + ".snapshot";
+	string tempName = fileName + ".tmp";
+	FILE* file = fopen(tempName.c_str(), "wb");
+	if (file == nullptr)
+		return FALSE;
+
+	BOOL success;
+	{
+		lock_guard<mutex> lock(m_snapshotLock);
+		SnapshotHeader header = { SNAPSHOT_MAGIC, JOURNAL_VERSION, uint32_t(m_snapshot.size()), 0 };
+		success = fwrite(&header, sizeof(header), 1, file) == 1;
+		for (auto it = m_snapshot.begin(); success && it != m_snapshot.end(); ++it)
+		{
+			SnapshotEntry entry = { it->first, it->second.state, it->second.sequence, it->second.timeNs };
+			success = fwrite(&entry, sizeof(entry), 1, file) == 1;
+		}
+	}
+
+	success = success && fflush(file) == 0 && fsync(fileno(file)) == 0;
+	fclose(file);
+	if (!success || rename(tempName.c_str(), fileName.c_str()) != 0)
+	{
+		remove(tempName.c_str());
+		return FALSE;
+	}
+	return TRUE;
+#endif
+}
@@ -0,0 +1,145 @@
+#ifndef _TRANSITION_JOURNAL_H
+#define _TRANSITION_JOURNAL_H
+
+#include "DataTypes.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief Append-only journal of state machine transitions for audit and crash
+/// recovery.
+///
+/// @details Fixed-size records are appended to a memory mapped segment file. An
+/// append claims a slot with an atomic increment and stores the record into the
+/// mapping; no system call is made on the caller's thread except when a full
+/// segment must be replaced and no spare segment is ready.
+///
+/// A background flusher thread periodically msync()s the active segment, keeps a
+/// spare segment ready for rotation and compacts each full segment into a
+/// per-machine latest-state snapshot file, after which the segment is deleted.
+/// Open() recovers any segments left behind by a previous run into the snapshot.
+///
+/// Files for a journal named "path/name" are "path/name.000001.seg", ... and
+/// "path/name.snapshot". Mapped segments are only supported on POSIX systems;
+/// elsewhere Open() returns FALSE and Append() does nothing.
+class TransitionJournal
+{
+public:
+	/// @brief Fixed-size transition record stored within a segment.
+	struct Record
+	{
+		std::uint64_t sequence;
+		std::uint64_t timeNs;
+		std::uint32_t machineId;
+		std::uint8_t fromState;
+		std::uint8_t toState;
+		std::uint16_t reserved;
+		std::uint32_t check;		// Written last; non-matching if the record is incomplete
+		std::uint32_t reserved2;
+	};
+
+	/// @brief Latest known state of one machine.
+	struct Snapshot
+	{
+		BYTE state;
+		std::uint64_t sequence;
+		std::uint64_t timeNs;
+	};
+
+	TransitionJournal();
+
+	/// Destructor. Closes the journal.
+	~TransitionJournal();
+
+	/// Open the journal, recover existing segments and start the flusher thread.
+	/// @param[in] name - the journal path and file name prefix.
+	/// @param[in] recordsPerSegment - the number of records in each segment file.
+	/// @param[in] flushInterval - the flusher thread msync() and compaction period.
+	/// @return TRUE if the journal was opened.
+	BOOL Open(const std::string& name, std::uint32_t recordsPerSegment = 65536,
+		std::chrono::milliseconds flushInterval = std::chrono::milliseconds(100));
+
+	/// Stop the flusher thread and compact all segments into the snapshot. All
+	/// Append() callers must have stopped before calling.
+	void Close();
+
+	/// Append a transition record. Thread-safe.
+	/// @param[in] machineId - the caller defined machine identifier.
+	/// @param[in] fromState - the state before the transition.
+	/// @param[in] toState - the state after the transition.
+	/// @return TRUE if the record was stored.
+	BOOL Append(UINT32 machineId, BYTE fromState, BYTE toState);
+
+	/// Get the latest state of a machine as of the last compaction.
+	/// @param[in] machineId - the machine identifier.
+	/// @param[out] snapshot - the latest known state.
+	/// @return TRUE if the machine has a journaled state.
+	BOOL GetLatestState(UINT32 machineId, Snapshot& snapshot) const;
+
+	/// Get the latest state of all machines as of the last compaction.
+	std::map<UINT32, Snapshot> GetLatestStates() const;
+
+	/// Get the number of records appended since Open().
+	std::uint64_t GetAppendedCount() const { return m_appended.load(std::memory_order_relaxed); }
+
+	/// Get the number of records discarded because a segment could not be created.
+	std::uint64_t GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+	TransitionJournal(const TransitionJournal&) = delete;
+	TransitionJournal& operator=(const TransitionJournal&) = delete;
+
+	struct Segment;
+
+	Segment* CreateSegment();
+	void DestroySegment(Segment* segment, bool remove);
+	BOOL Rotate(Segment* full);
+	void WaitForAppenders();
+	void Flush(Segment* segment);
+	void Compact(const Record* records, std::uint32_t count);
+	void CompactSegment(Segment* segment);
+	BOOL Recover();
+	BOOL LoadSnapshot();
+	BOOL SaveSnapshot();
+	void Process();
+
+	std::string m_name;
+	std::uint32_t m_recordsPerSegment;
+	std::chrono::milliseconds m_flushInterval;
+
+	/// Segment receiving appends. Replaced under m_lock; read lock-free.
+	std::atomic<Segment*> m_active;
+
+	/// Full segments waiting for in-flight appends to finish before compaction.
+	std::vector<Segment*> m_sealed;
+
+	/// Segment created ahead of time by the flusher thread for the next rotation.
+	Segment* m_spare;
+
+	std::atomic<std::uint64_t> m_nextSegment;
+	std::atomic<std::uint64_t> m_nextSequence;
+	std::atomic<std::uint64_t> m_appended;
+	std::atomic<std::uint64_t> m_dropped;
+
+	/// Appends in flight, counted in the slot selected by m_epoch when each
+	/// started. The flusher advances the epoch and waits for the old slot to
+	/// drain before destroying a sealed segment.
+	std::atomic<std::uint32_t> m_epoch;
+	std::atomic<std::uint32_t> m_inFlight[2];
+
+	std::mutex m_lock;
+	std::condition_variable m_cv;
+	std::thread m_flusher;
+	bool m_stop;
+
+	mutable std::mutex m_snapshotLock;
+	std::map<UINT32, Snapshot> m_snapshot;
+};
+
+#endif
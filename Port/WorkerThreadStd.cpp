@@ -2,6 +2,10 @@
 #include "WorkerThreadStd.h"
 #include "ThreadMsg.h"
 #include "Timer.h"
+#include "Tracer.h"
+#include <typeinfo>
+#include <algorithm>
+#include <stdexcept>
 
 #ifdef WIN32
 #include <Windows.h>
@@ -14,10 +18,55 @@ using namespace DelegateLib;
 #define MSG_EXIT_THREAD			2
 #define MSG_TIMER				3
 
+// Running worker threads for ForEachWorker() and the timer service thread
+// posting timer messages to them. Never destroyed, since static worker threads
+// may exit after static destruction has begun.
+struct WorkerList
+{
+	std::mutex lock;
+	std::vector<WorkerThread*> workers;
+
+	std::unique_ptr<std::thread> timerService;
+	std::condition_variable timerCv;
+	bool timerExit = false;
+
+	// The worker the timer service is posting to, and the next worker to post to
+	WorkerThread* timerTarget = nullptr;
+	size_t timerNext = 0;
+};
+
+static WorkerList& GetWorkerList()
+{
+	static WorkerList* list = new WorkerList();
+	return *list;
+}
+
+// The worker running on the calling thread, if any
+static thread_local const WorkerThread* t_currentWorker = nullptr;
+
+//----------------------------------------------------------------------------
+// GetChargedSize
+//----------------------------------------------------------------------------
+static size_t GetChargedSize(const DelegateMsg& msg)
+{
+	return msg.GetSize() + sizeof(ThreadMsg);
+}
+
+//----------------------------------------------------------------------------
+// GetTimeNs
+//----------------------------------------------------------------------------
+static uint64_t GetTimeNs()
+{
+	return uint64_t(chrono::duration_cast<chrono::nanoseconds>(
+		chrono::steady_clock::now().time_since_epoch()).count());
+}
+
 //----------------------------------------------------------------------------
 // WorkerThread
 //----------------------------------------------------------------------------
-WorkerThread::WorkerThread(const std::string& threadName) : m_thread(nullptr), m_timerExit(false), THREAD_NAME(threadName)
+WorkerThread::WorkerThread(const std::string& threadName) : m_arena(make_shared<DelegateArena>()), m_budget(&MessageBudget::GetGlobal()), m_thread(nullptr), m_exitPosted(false), THREAD_NAME(threadName),
+	m_minorFrame(0), m_frames(0), m_overruns(0), m_skippedFrames(0), m_fair(false), m_deficit(0), m_exitPending(false),
+	m_invokeStartNs(0), m_invokeTarget(nullptr), m_invokes(0), m_invokeTotalNs(0), m_invokeMaxNs(0)
 {
 }
 
@@ -36,8 +85,14 @@ bool WorkerThread::CreateThread()
 {
 	if (!m_thread)
 	{
+		m_exitPosted = false;
 		m_thread = std::unique_ptr<std::thread>(new thread(&WorkerThread::Process, this));
 
+		WorkerList& list = GetWorkerList();
+		lock_guard<mutex> lock(list.lock);
+		list.workers.push_back(this);
+		StartTimerService(list);
+
 #ifdef WIN32
 		// Get the thread's native Windows handle
 		auto handle = m_thread->native_handle();
@@ -54,6 +109,49 @@ bool WorkerThread::CreateThread()
 	return true;
 }
 
+//----------------------------------------------------------------------------
+// CreateThreads
+//----------------------------------------------------------------------------
+bool WorkerThread::CreateThreads(const std::vector<WorkerThread*>& workers, unsigned parallelism)
+{
+	if (parallelism == 0)
+		parallelism = thread::hardware_concurrency() > 0 ? thread::hardware_concurrency() : 1;
+	if (parallelism > workers.size())
+		parallelism = unsigned(workers.size());
+
+	// Each helper creates an interleaved share of the workers; the caller
+	// creates the first share
+	atomic<bool> success(true);
+	auto create = [&workers, &success, parallelism](size_t first) {
+		for (size_t i = first; i < workers.size(); i += parallelism)
+		{
+			if (!workers[i]->CreateThread())
+				success = false;
+		}
+	};
+
+	vector<thread> helpers;
+	for (unsigned i = 1; i < parallelism; i++)
+		helpers.emplace_back(create, i);
+	create(0);
+	for (thread& helper : helpers)
+		helper.join();
+	return success;
+}
+
+//----------------------------------------------------------------------------
+// ExitThreads
+//----------------------------------------------------------------------------
+void WorkerThread::ExitThreads(const std::vector<WorkerThread*>& workers)
+{
+	// Post every exit message before joining any thread, so the threads wind 
+	// down concurrently
+	for (WorkerThread* worker : workers)
+		worker->PostExit();
+	for (WorkerThread* worker : workers)
+		worker->ExitThread();
+}
+
 //----------------------------------------------------------------------------
 // GetThreadId
 //----------------------------------------------------------------------------
@@ -79,7 +177,10 @@ std::thread::id WorkerThread::GetCurrentThreadId()
 size_t WorkerThread::GetQueueSize()
 {
 	lock_guard<mutex> lock(m_mutex);
-	return m_queue.size();
+	size_t size = m_queue.size();
+	for (ProducerQueue* producer : m_active)
+		size += producer->queue.size();
+	return size;
 }
 
 //----------------------------------------------------------------------------
@@ -90,18 +191,311 @@ void WorkerThread::ExitThread()
 	if (!m_thread)
 		return;
 
+	PostExit();
+
+    m_thread->join();
+    m_thread = nullptr;
+}
+
+//----------------------------------------------------------------------------
+// PostExit
+//----------------------------------------------------------------------------
+void WorkerThread::PostExit()
+{
+	if (!m_thread || m_exitPosted)
+		return;
+	m_exitPosted = true;
+
+	// The last worker to exit stops the timer service thread
+	std::unique_ptr<std::thread> timerService;
+	{
+		WorkerList& list = GetWorkerList();
+		std::unique_lock<std::mutex> lock(list.lock);
+		list.workers.erase(std::remove(list.workers.begin(), list.workers.end(), this), list.workers.end());
+
+		// Wait for a timer message being posted to this worker outside the lock
+		list.timerCv.wait(lock, [&list, this] { return list.timerTarget != this; });
+
+		if (list.workers.empty() && list.timerService)
+		{
+			list.timerExit = true;
+			list.timerCv.notify_all();
+			timerService = std::move(list.timerService);
+		}
+	}
+	if (timerService)
+		timerService->join();
+
 	// Create a new ThreadMsg
 	std::shared_ptr<ThreadMsg> threadMsg(new ThreadMsg(MSG_EXIT_THREAD, 0));
 
 	// Put exit thread message into the queue
 	{
 		lock_guard<mutex> lock(m_mutex);
-		m_queue.push(threadMsg);
+		Enqueue(threadMsg);
 		m_cv.notify_one();
 	}
+}
 
-    m_thread->join();
-    m_thread = nullptr;
+//----------------------------------------------------------------------------
+// SetCyclic
+//----------------------------------------------------------------------------
+void WorkerThread::SetCyclic(std::chrono::microseconds minorFrame)
+{
+	if (m_thread)
+		throw std::logic_error("Cyclic schedule must be set before CreateThread");
+	if (minorFrame.count() <= 0)
+		throw std::invalid_argument("Minor frame must be positive");
+
+	m_minorFrame = minorFrame;
+	if (!m_jitter)
+		m_jitter.reset(new LatencyHistogram(1));
+}
+
+//----------------------------------------------------------------------------
+// AddCyclicTask
+//----------------------------------------------------------------------------
+void WorkerThread::AddCyclicTask(const Delegate<void()>& task, unsigned period, unsigned offset)
+{
+	if (m_thread)
+		throw std::logic_error("Cyclic schedule must be set before CreateThread");
+	if (period == 0)
+		throw std::invalid_argument("Task period must be positive");
+
+	Delegate<void()>* clone = task.Clone();
+	if (!clone)
+		BAD_ALLOC();
+
+	CyclicTask entry;
+	entry.task.reset(clone);
+	entry.period = period;
+	entry.offset = offset % period;
+	m_cyclicTasks.push_back(std::move(entry));
+}
+
+//----------------------------------------------------------------------------
+// GetCyclicStats
+//----------------------------------------------------------------------------
+WorkerThread::CyclicStats WorkerThread::GetCyclicStats()
+{
+	CyclicStats stats;
+	stats.frames = m_frames;
+	stats.overruns = m_overruns;
+	stats.skippedFrames = m_skippedFrames;
+	if (m_jitter)
+		stats.jitter = m_jitter->GetSnapshot();
+	return stats;
+}
+
+//----------------------------------------------------------------------------
+// SetFairQueuing
+//----------------------------------------------------------------------------
+void WorkerThread::SetFairQueuing(bool enable)
+{
+	if (m_thread)
+		throw std::logic_error("Fair queuing must be set before CreateThread");
+	m_fair = enable;
+}
+
+//----------------------------------------------------------------------------
+// SetProducerWeight
+//----------------------------------------------------------------------------
+void WorkerThread::SetProducerWeight(std::thread::id producer, unsigned weight)
+{
+	lock_guard<mutex> lock(m_mutex);
+	std::unique_ptr<ProducerQueue>& entry = m_producers[producer];
+	if (!entry)
+		entry.reset(new ProducerQueue());
+	entry->weight = weight > 0 ? weight : 1;
+}
+
+//----------------------------------------------------------------------------
+// GetProducerStats
+//----------------------------------------------------------------------------
+std::vector<WorkerThread::ProducerStats> WorkerThread::GetProducerStats()
+{
+	lock_guard<mutex> lock(m_mutex);
+	std::vector<ProducerStats> stats;
+	for (auto& entry : m_producers)
+	{
+		const ProducerQueue& producer = *entry.second;
+		ProducerStats s;
+		s.producer = entry.first;
+		s.weight = producer.weight;
+		s.messages = producer.messages;
+		s.queued = producer.queue.size();
+		s.maxQueued = producer.maxQueued;
+		s.meanWaitNs = producer.messages ? producer.totalWaitNs / producer.messages : 0;
+		s.maxWaitNs = producer.maxWaitNs;
+		stats.push_back(s);
+	}
+	return stats;
+}
+
+//----------------------------------------------------------------------------
+// GetInvocation
+//----------------------------------------------------------------------------
+bool WorkerThread::GetInvocation(uint64_t& startNs, const char*& target) const
+{
+	// Retry if the invocation changed while reading the pair
+	while (1)
+	{
+		startNs = m_invokeStartNs.load(memory_order_acquire);
+		if (startNs == 0)
+			return false;
+		target = m_invokeTarget.load(memory_order_acquire);
+		if (m_invokeStartNs.load(memory_order_acquire) == startNs)
+			return true;
+	}
+}
+
+//----------------------------------------------------------------------------
+// SetInvocation
+//----------------------------------------------------------------------------
+void WorkerThread::SetInvocation(const char* target)
+{
+	if (target)
+	{
+		m_invokeStartNs.store(0, memory_order_relaxed);
+		m_invokeTarget.store(target, memory_order_release);
+		m_invokeStartNs.store(GetTimeNs(), memory_order_release);
+	}
+	else
+	{
+		uint64_t startNs = m_invokeStartNs.load(memory_order_relaxed);
+		m_invokeStartNs.store(0, memory_order_release);
+		if (startNs == 0)
+			return;
+
+		// Single writer, so load and store rather than read-modify-write
+		uint64_t durationNs = GetTimeNs() - startNs;
+		m_invokes.store(m_invokes.load(memory_order_relaxed) + 1, memory_order_relaxed);
+		m_invokeTotalNs.store(m_invokeTotalNs.load(memory_order_relaxed) + durationNs, memory_order_relaxed);
+		if (durationNs > m_invokeMaxNs.load(memory_order_relaxed))
+			m_invokeMaxNs.store(durationNs, memory_order_relaxed);
+	}
+}
+
+//----------------------------------------------------------------------------
+// GetInvokeStats
+//----------------------------------------------------------------------------
+WorkerThread::InvokeStats WorkerThread::GetInvokeStats() const
+{
+	InvokeStats stats;
+	stats.invokes = m_invokes.load(memory_order_relaxed);
+	stats.totalNs = m_invokeTotalNs.load(memory_order_relaxed);
+	stats.maxNs = m_invokeMaxNs.load(memory_order_relaxed);
+	return stats;
+}
+
+//----------------------------------------------------------------------------
+// ForEachWorker
+//----------------------------------------------------------------------------
+void WorkerThread::ForEachWorker(const std::function<void(WorkerThread&)>& func)
+{
+	WorkerList& list = GetWorkerList();
+	lock_guard<mutex> lock(list.lock);
+	for (WorkerThread* worker : list.workers)
+		func(*worker);
+}
+
+//----------------------------------------------------------------------------
+// Enqueue
+//----------------------------------------------------------------------------
+void WorkerThread::Enqueue(const std::shared_ptr<ThreadMsg>& msg)
+{
+	// The exit message stays in the FIFO queue, serviced once the producer
+	// sub-queues are empty. As with one FIFO queue, only the messages queued
+	// before it run, so a producer that keeps dispatching cannot delay the exit.
+	if (!m_fair || msg->GetId() == MSG_EXIT_THREAD)
+	{
+		if (m_fair && msg->GetId() == MSG_EXIT_THREAD)
+		{
+			m_exitPending = true;
+			for (auto& entry : m_producers)
+				entry.second->exitQuota = entry.second->queue.size();
+		}
+		m_queue.push(msg);
+		return;
+	}
+
+	std::unique_ptr<ProducerQueue>& entry = m_producers[this_thread::get_id()];
+	if (!entry)
+		entry.reset(new ProducerQueue());
+	ProducerQueue* producer = entry.get();
+
+	msg->SetQueueTime(GetTimeNs());
+	if (producer->queue.empty())
+		m_active.push_back(producer);
+	producer->queue.push(msg);
+	if (producer->queue.size() > producer->maxQueued)
+		producer->maxQueued = producer->queue.size();
+}
+
+//----------------------------------------------------------------------------
+// Dequeue
+//----------------------------------------------------------------------------
+std::shared_ptr<ThreadMsg> WorkerThread::Dequeue()
+{
+	std::shared_ptr<ThreadMsg> msg;
+
+	// Once the exit message is queued, a producer leaves the rotation when the
+	// messages it queued before the exit have been serviced
+	while (m_exitPending && !m_active.empty() && m_active.front()->exitQuota == 0)
+	{
+		m_active.pop_front();
+		m_deficit = 0;
+	}
+
+	if (!m_active.empty())
+	{
+		// A producer's turn starts with a deficit of its weight in messages
+		ProducerQueue* producer = m_active.front();
+		if (m_deficit == 0)
+			m_deficit = producer->weight;
+
+		msg = producer->queue.front();
+		producer->queue.pop();
+		m_deficit--;
+		if (m_exitPending)
+			producer->exitQuota--;
+
+		uint64_t wait = GetTimeNs() - msg->GetQueueTime();
+		producer->messages++;
+		producer->totalWaitNs += wait;
+		if (wait > producer->maxWaitNs)
+			producer->maxWaitNs = wait;
+
+		// End the turn when the deficit is spent or the sub-queue is empty
+		if (producer->queue.empty())
+		{
+			m_active.pop_front();
+			m_deficit = 0;
+		}
+		else if (m_deficit == 0)
+		{
+			m_active.pop_front();
+			m_active.push_back(producer);
+		}
+	}
+	else if (!m_queue.empty())
+	{
+		msg = m_queue.front();
+		m_queue.pop();
+
+		// Messages dispatched after the exit stay queued, as they do behind the
+		// exit message in one FIFO queue, so return their producers to the rotation
+		if (m_exitPending && msg->GetId() == MSG_EXIT_THREAD)
+		{
+			m_exitPending = false;
+			for (auto& entry : m_producers)
+			{
+				if (!entry.second->queue.empty())
+					m_active.push_back(entry.second.get());
+			}
+		}
+	}
+	return msg;
 }
 
 //----------------------------------------------------------------------------
@@ -112,31 +506,117 @@ void WorkerThread::DispatchDelegate(std::shared_ptr<DelegateLib::DelegateMsg> ms
 	if (m_thread == nullptr)
 		throw std::invalid_argument("Thread pointer is null");
 
-	// Create a new ThreadMsg
-    std::shared_ptr<ThreadMsg> threadMsg(new ThreadMsg(MSG_DISPATCH_DELEGATE, msg));
+	// Charge the memory budget, discarding the message or waiting for room once
+	// over the limit. A message this thread dispatches to itself is neither
+	// discarded nor waited on; it is typically a continuation, such as a state
+	// machine resuming a chain cut short by its run budget. A message the
+	// source thread waits on is not held here either, since the wait has its
+	// own timeout.
+	bool self = (t_currentWorker == this);
+	bool sheddable = msg->IsSheddable() && !self;
+	size_t charged = GetChargedSize(*msg);
+	if (!m_budget.Acquire(charged, sheddable, sheddable))
+	{
+		msg->OnDiscarded();
+		return;
+	}
+
+	// Create a new ThreadMsg within the arena; the worker thread releases it.
+	// The budget charge is released when the message is destroyed, so messages
+	// still queued when the thread exits are released too.
+	std::shared_ptr<ThreadMsg> threadMsg;
+	try
+	{
+		threadMsg = allocate_shared<ThreadMsg>(ArenaAllocator<ThreadMsg>(m_arena), MSG_DISPATCH_DELEGATE, msg);
+	}
+	catch (...)
+	{
+		m_budget.Release(charged);
+		throw;
+	}
+	threadMsg->SetBudgetCharge(&m_budget, charged);
+
+	// Link this dispatch to the destination thread invoke within the trace
+	TraceSpan span("DispatchDelegate", "delegate");
+	if (Tracer::IsEnabled())
+	{
+		threadMsg->SetTraceId(Tracer::NewFlowId());
+		Tracer::FlowBegin(threadMsg->GetTraceId());
+	}
 
 	// Add dispatch delegate msg to queue and notify worker thread
 	std::unique_lock<std::mutex> lk(m_mutex);
-	m_queue.push(threadMsg);
+	Enqueue(threadMsg);
 	m_cv.notify_one();
 }
 
 //----------------------------------------------------------------------------
-// TimerThread
+// OnTimerArmed
+//----------------------------------------------------------------------------
+void WorkerThread::OnTimerArmed()
+{
+	WorkerList& list = GetWorkerList();
+	lock_guard<mutex> lock(list.lock);
+	StartTimerService(list);
+}
+
+//----------------------------------------------------------------------------
+// StartTimerService
+//----------------------------------------------------------------------------
+void WorkerThread::StartTimerService(WorkerList& list)
+{
+	// Called with the list lock held. A timer started before the handler was
+	// set is seen by the IsArmed() check.
+	static bool handlerSet = false;
+	if (!handlerSet)
+	{
+		Timer::SetArmedHandler(&WorkerThread::OnTimerArmed);
+		handlerSet = true;
+	}
+
+	if (list.timerService || list.workers.empty() || !Timer::IsArmed())
+		return;
+
+	list.timerExit = false;
+	list.timerService = std::unique_ptr<std::thread>(new thread(&WorkerThread::TimerService));
+}
+
+//----------------------------------------------------------------------------
+// TimerService
 //----------------------------------------------------------------------------
-void WorkerThread::TimerThread()
+void WorkerThread::TimerService()
 {
-    while (!m_timerExit)
-    {
-        std::this_thread::sleep_for(100ms);
+	Tracer::SetThreadName("TimerService");
+
+	WorkerList& list = GetWorkerList();
+	std::unique_lock<std::mutex> lk(list.lock);
+	while (1)
+	{
+		if (list.timerCv.wait_for(lk, 100ms, [&list] { return list.timerExit; }))
+			return;
 
-        std::shared_ptr<ThreadMsg> threadMsg (new ThreadMsg(MSG_TIMER, 0));
+		if (list.workers.empty())
+			continue;
 
-        // Add timer msg to queue and notify worker thread
-        std::unique_lock<std::mutex> lk(m_mutex);
-        m_queue.push(threadMsg);
-        m_cv.notify_one();
-    }
+		// ProcessTimers() services every timer, so one worker per tick is
+		// enough. Rotate through the workers to share the load.
+		WorkerThread* worker = list.workers[list.timerNext++ % list.workers.size()];
+		list.timerTarget = worker;
+		lk.unlock();
+
+		// Add timer msg to the worker queue and notify the worker thread. The
+		// worker's PostExit() waits while it is the target.
+		std::shared_ptr<ThreadMsg> threadMsg(new ThreadMsg(MSG_TIMER, 0));
+		{
+			lock_guard<mutex> workerLock(worker->m_mutex);
+			worker->Enqueue(threadMsg);
+			worker->m_cv.notify_one();
+		}
+
+		lk.lock();
+		list.timerTarget = nullptr;
+		list.timerCv.notify_all();
+	}
 }
 
 //----------------------------------------------------------------------------
@@ -144,56 +624,140 @@ void WorkerThread::TimerThread()
 //----------------------------------------------------------------------------
 void WorkerThread::Process()
 {
-    m_timerExit = false;
-    std::thread timerThread(&WorkerThread::TimerThread, this);
+	Tracer::SetThreadName(THREAD_NAME);
+	t_currentWorker = this;
+
+	if (m_minorFrame.count() > 0)
+		ProcessCyclic();
+	else
+		ProcessQueue();
+}
 
+//----------------------------------------------------------------------------
+// ProcessQueue
+//----------------------------------------------------------------------------
+void WorkerThread::ProcessQueue()
+{
 	while (1)
 	{
 		std::shared_ptr<ThreadMsg> msg;
 		{
 			// Wait for a message to be added to the queue
 			std::unique_lock<std::mutex> lk(m_mutex);
-			while (m_queue.empty())
+			while (IsQueueEmpty())
 				m_cv.wait(lk);
 
-			if (m_queue.empty())
+			msg = Dequeue();
+			if (!msg)
 				continue;
-
-			msg = m_queue.front();
-			m_queue.pop();
 		}
 
-		switch (msg->GetId())
-		{
-			case MSG_DISPATCH_DELEGATE:
-			{
-				// Get pointer to DelegateMsg data from queue msg data
-                auto delegateMsg = msg->GetData();
-				ASSERT_TRUE(delegateMsg);
+		if (!DispatchMsg(msg))
+			return;
+	}
+}
+
+//----------------------------------------------------------------------------
+// ProcessCyclic
+//----------------------------------------------------------------------------
+void WorkerThread::ProcessCyclic()
+{
+	const auto start = chrono::steady_clock::now();
+	uint64_t frame = 0;
 
-				auto invoker = delegateMsg->GetDelegateInvoker();
-				ASSERT_TRUE(invoker);
+	while (1)
+	{
+		const auto boundary = start + m_minorFrame * frame;
 
-				// Invoke the delegate destination target function
-				bool success = invoker->Invoke(delegateMsg);
-				ASSERT_TRUE(success);
-				break;
+		// Slack time; process messages until the frame boundary
+		std::shared_ptr<ThreadMsg> msg;
+		{
+			std::unique_lock<std::mutex> lk(m_mutex);
+			while (IsQueueEmpty())
+			{
+				if (m_cv.wait_until(lk, boundary) == cv_status::timeout)
+					break;
 			}
 
-            case MSG_TIMER:
-                Timer::ProcessTimers();
-                break;
+			// Never start a message once the boundary has passed
+			if (chrono::steady_clock::now() < boundary)
+				msg = Dequeue();
+		}
 
-			case MSG_EXIT_THREAD:
+		if (msg)
+		{
+			if (!DispatchMsg(msg))
+				return;
+			continue;
+		}
+
+		// Frame boundary; run the tasks due in this frame
+		m_jitter->Record(chrono::steady_clock::now() - boundary);
+		m_frames++;
+		for (CyclicTask& entry : m_cyclicTasks)
+		{
+			if (frame % entry.period == entry.offset)
 			{
-                m_timerExit = true;
-                timerThread.join();
-                return;
+				SetInvocation(typeid(*entry.task).name());
+				(*entry.task)();
+				SetInvocation(nullptr);
 			}
+		}
+		frame++;
 
-			default:
-				throw std::invalid_argument("Invalid message ID");
+		// On overrun skip the frames whose boundary has passed, keeping the
+		// schedule aligned to the start time
+		const auto end = chrono::steady_clock::now();
+		if (end > start + m_minorFrame * frame)
+		{
+			m_overruns++;
+			uint64_t current = uint64_t((end - start) / m_minorFrame) + 1;
+			m_skippedFrames += current - frame;
+			frame = current;
 		}
 	}
 }
 
+//----------------------------------------------------------------------------
+// DispatchMsg
+//----------------------------------------------------------------------------
+bool WorkerThread::DispatchMsg(const std::shared_ptr<ThreadMsg>& msg)
+{
+	switch (msg->GetId())
+	{
+		case MSG_DISPATCH_DELEGATE:
+		{
+			// Get pointer to DelegateMsg data from queue msg data
+            auto delegateMsg = msg->GetData();
+			ASSERT_TRUE(delegateMsg);
+
+			auto invoker = delegateMsg->GetDelegateInvoker();
+			ASSERT_TRUE(invoker);
+
+			// Trace the invoke span named by the delegate type
+			TraceSpan span(Tracer::IsEnabled() ? typeid(*invoker).name() : "", "delegate", true);
+			if (msg->GetTraceId())
+				Tracer::FlowEnd(msg->GetTraceId());
+
+			// Invoke the delegate destination target function, published for the
+			// stall watchdog
+			SetInvocation(typeid(*invoker).name());
+			bool success = invoker->Invoke(delegateMsg);
+			SetInvocation(nullptr);
+			ASSERT_TRUE(success);
+			return true;
+		}
+
+        case MSG_TIMER:
+            SetInvocation("Timer::ProcessTimers");
+            Timer::ProcessTimers();
+            SetInvocation(nullptr);
+            return true;
+
+		case MSG_EXIT_THREAD:
+			return false;
+
+		default:
+			throw std::invalid_argument("Invalid message ID");
+	}
+}
@@ -6,13 +6,22 @@
 
 #include "DelegateOpt.h"
 #include "DelegateThread.h"
+#include "Delegate.h"
+#include "LatencyHistogram.h"
+#include "MessageBudget.h"
+#include <chrono>
 #include <thread>
 #include <queue>
+#include <deque>
+#include <unordered_map>
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
+#include <functional>
+#include <vector>
 
 class ThreadMsg;
+struct WorkerList;
 
 class WorkerThread : public DelegateLib::DelegateThread
 {
@@ -30,6 +39,19 @@ public:
 	/// Called once a program exit to exit the worker thread
 	void ExitThread();
 
+	/// Create a group of worker threads using parallel helper threads. Faster
+	/// than calling CreateThread() on each in turn when starting many workers.
+	/// @param[in] workers - the workers to create.
+	/// @param[in] parallelism - the number of creating threads, including the
+	///		caller. 0 uses the hardware concurrency.
+	/// @return TRUE if every thread is created. FALSE otherwise.
+	static bool CreateThreads(const std::vector<WorkerThread*>& workers, unsigned parallelism = 0);
+
+	/// Exit a group of worker threads. Every exit message is posted before any
+	/// thread is joined, so the threads exit concurrently.
+	/// @param[in] workers - the workers to exit.
+	static void ExitThreads(const std::vector<WorkerThread*>& workers);
+
 	/// Get the ID of this thread instance
 	std::thread::id GetThreadId();
 
@@ -44,6 +66,113 @@ public:
 
 	virtual void DispatchDelegate(std::shared_ptr<DelegateLib::DelegateMsg> msg);
 
+	/// Get the arena that messages dispatched to this thread are allocated from.
+	virtual std::shared_ptr<DelegateLib::DelegateArena> GetArena() { return m_arena; }
+
+	/// Statistics of the cyclic executive schedule.
+	struct CyclicStats
+	{
+		/// Minor frames started.
+		uint64_t frames;
+
+		/// Frames whose tasks finished after the next frame boundary.
+		uint64_t overruns;
+
+		/// Frames not started because an overrun passed their boundary.
+		uint64_t skippedFrames;
+
+		/// Lateness of each frame start in nanoseconds.
+		LatencySnapshot jitter;
+	};
+
+	/// Enable time-triggered (cyclic executive) scheduling. At each minor frame
+	/// boundary the tasks due in that frame run in the order added. Queued messages
+	/// are processed in the slack time until the next boundary; a message is never
+	/// started once the boundary has passed. Call before CreateThread().
+	/// @param[in] minorFrame - the minor frame period.
+	void SetCyclic(std::chrono::microseconds minorFrame);
+
+	/// Add a task to the static frame table. Call before CreateThread().
+	/// @param[in] task - the task invoked on this thread. A clone is stored.
+	/// @param[in] period - the task period in minor frames.
+	/// @param[in] offset - the first minor frame the task runs in. Use different
+	///		offsets to spread tasks of the same period over separate frames.
+	void AddCyclicTask(const DelegateLib::Delegate<void()>& task, unsigned period, unsigned offset = 0);
+
+	/// Get the cyclic schedule statistics. May be called from any thread.
+	CyclicStats GetCyclicStats();
+
+	/// Statistics of one producer's sub-queue.
+	struct ProducerStats
+	{
+		/// The producer (source) thread.
+		std::thread::id producer;
+
+		/// Messages serviced per round robin turn.
+		unsigned weight;
+
+		/// Messages dispatched to this thread.
+		uint64_t messages;
+
+		/// Messages currently queued, and the most ever queued.
+		size_t queued;
+		size_t maxQueued;
+
+		/// Time from queuing to dequeue in nanoseconds.
+		uint64_t meanWaitNs;
+		uint64_t maxWaitNs;
+	};
+
+	/// Enable per-producer fair queuing. Each source thread dispatching to this
+	/// thread is given its own sub-queue. Sub-queues with pending messages are
+	/// serviced deficit round robin: a producer's turn dequeues up to its weight
+	/// in messages before the next producer's turn, so a flooding producer delays
+	/// another producer's message by at most the sum of the other weights. Call
+	/// before CreateThread().
+	/// @param[in] enable - TRUE to queue per producer; FALSE for one FIFO queue.
+	void SetFairQueuing(bool enable);
+
+	/// Set the number of messages a producer may dequeue per turn. May be called
+	/// from any thread at any time.
+	/// @param[in] producer - the source thread.
+	/// @param[in] weight - the messages per turn. Default is 1.
+	void SetProducerWeight(std::thread::id producer, unsigned weight);
+
+	/// Get the statistics of every producer that has dispatched to this thread
+	/// with fair queuing enabled. May be called from any thread.
+	std::vector<ProducerStats> GetProducerStats();
+
+	/// Get the memory budget charged with each delegate message queued to this
+	/// thread until it is invoked. Each message is also charged to
+	/// MessageBudget::GetGlobal(). Call SetLimit() to bound the bytes queued.
+	MessageBudget& GetMessageBudget() { return m_budget; }
+
+	/// Get the invocation currently running on this thread. Lock-free; may be
+	/// called from any thread.
+	/// @param[out] startNs - the steady clock time the invocation started in nanoseconds.
+	/// @param[out] target - the invoked target type name.
+	/// @return TRUE if an invocation is running.
+	bool GetInvocation(uint64_t& startNs, const char*& target) const;
+
+	/// Statistics of the invocations run on this thread.
+	struct InvokeStats
+	{
+		/// Delegate invocations, timer services and cyclic tasks completed.
+		uint64_t invokes;
+
+		/// Total and longest invocation time in nanoseconds.
+		uint64_t totalNs;
+		uint64_t maxNs;
+	};
+
+	/// Get the invocation statistics. Lock-free; may be called from any thread.
+	InvokeStats GetInvokeStats() const;
+
+	/// Call a function for each running worker thread. Workers cannot exit until
+	/// the call returns.
+	/// @param[in] func - the function called with each worker.
+	static void ForEachWorker(const std::function<void(WorkerThread&)>& func);
+
 private:
 	WorkerThread(const WorkerThread&) = delete;
 	WorkerThread& operator=(const WorkerThread&) = delete;
@@ -51,15 +180,107 @@ private:
 	/// Entry point for the thread
 	void Process();
 
-    /// Entry point for timer thread
-    void TimerThread();
+	/// Process messages in arrival order until the exit message
+	void ProcessQueue();
+
+	/// Run the frame table, processing messages in slack time, until the exit message
+	void ProcessCyclic();
+
+	/// Handle one message
+	/// @return FALSE if the thread must exit.
+	bool DispatchMsg(const std::shared_ptr<ThreadMsg>& msg);
+
+	/// Queue a message. Called with m_mutex held.
+	void Enqueue(const std::shared_ptr<ThreadMsg>& msg);
+
+	/// Dequeue the next message. Called with m_mutex held.
+	/// @return The message, or nullptr if none.
+	std::shared_ptr<ThreadMsg> Dequeue();
+
+	/// Publish the start of an invocation, or idle if target is NULL. Ending an
+	/// invocation adds its duration to the invocation statistics.
+	void SetInvocation(const char* target);
+
+	/// Any messages queued? Called with m_mutex held.
+	bool IsQueueEmpty() const { return m_queue.empty() && m_active.empty(); }
+
+	/// Post the exit message, unless already posted
+	void PostExit();
+
+	/// Entry point for the timer service thread, shared by all workers. Posts a
+	/// timer message to one running worker each tick, rotating between them.
+	static void TimerService();
+
+	/// Start the timer service thread if a timer is armed and any worker is
+	/// running. Called with the worker list lock held.
+	static void StartTimerService(WorkerList& list);
+
+	/// Called by Timer when the first timer is started
+	static void OnTimerArmed();
+
+	/// Declared before the queue so queued messages are released first
+	std::shared_ptr<DelegateLib::DelegateArena> m_arena;
+
+	/// Bytes held by queued delegate messages
+	MessageBudget m_budget;
 
 	std::unique_ptr<std::thread> m_thread;
 	std::queue<std::shared_ptr<ThreadMsg>> m_queue;
 	std::mutex m_mutex;
 	std::condition_variable m_cv;
-    std::atomic<bool> m_timerExit;
+	bool m_exitPosted;
 	const std::string THREAD_NAME;
+
+	/// Frame table entry
+	struct CyclicTask
+	{
+		std::unique_ptr<DelegateLib::Delegate<void()>> task;
+		unsigned period;
+		unsigned offset;
+	};
+
+	std::chrono::microseconds m_minorFrame;
+	std::vector<CyclicTask> m_cyclicTasks;
+	std::atomic<uint64_t> m_frames;
+	std::atomic<uint64_t> m_overruns;
+	std::atomic<uint64_t> m_skippedFrames;
+	std::unique_ptr<LatencyHistogram> m_jitter;
+
+	/// Fair queuing sub-queue of one producer
+	struct ProducerQueue
+	{
+		std::queue<std::shared_ptr<ThreadMsg>> queue;
+		unsigned weight = 1;
+		uint64_t messages = 0;
+		size_t maxQueued = 0;
+		uint64_t totalWaitNs = 0;
+		uint64_t maxWaitNs = 0;
+
+		/// Messages still to service before the pending exit message
+		size_t exitQuota = 0;
+	};
+
+	bool m_fair;
+	std::unordered_map<std::thread::id, std::unique_ptr<ProducerQueue>> m_producers;
+
+	/// Producers with queued messages in round robin order; the front has the turn
+	std::deque<ProducerQueue*> m_active;
+
+	/// Messages the front producer may still dequeue this turn
+	unsigned m_deficit;
+
+	/// The exit message is queued; producers are serviced up to their exit quota
+	bool m_exitPending;
+
+	/// The running invocation start time in steady clock nanoseconds, 0 if idle,
+	/// and its target. Written by this thread only; read by any thread.
+	std::atomic<uint64_t> m_invokeStartNs;
+	std::atomic<const char*> m_invokeTarget;
+
+	/// Invocation statistics. Written by this thread only; read by any thread.
+	std::atomic<uint64_t> m_invokes;
+	std::atomic<uint64_t> m_invokeTotalNs;
+	std::atomic<uint64_t> m_invokeMaxNs;
 };
 
 #endif 
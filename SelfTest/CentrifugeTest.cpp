@@ -6,9 +6,19 @@
 // CentrifugeTest
 //------------------------------------------------------------------------------
 CentrifugeTest::CentrifugeTest() :
-	SelfTest(ST_MAX_STATES),
-	m_speed(0)
+	SelfTest(ST_MAX_STATES)
 {
+	SetStateVariant(&m_stateData);
+	SetStatePublisher(&m_status);
+}
+
+//------------------------------------------------------------------------------
+// CaptureStatus
+//------------------------------------------------------------------------------
+void CentrifugeTest::CaptureStatus(Status& status)
+{
+	Spinning* spinning = m_stateData.Get<Spinning>();
+	status.speed = spinning ? spinning->speed : 0;
 }
 
 //------------------------------------------------------------------------------
@@ -50,7 +60,7 @@ void CentrifugeTest::Poll()
 //------------------------------------------------------------------------------
 STATE_DEFINE(CentrifugeTest, Idle, NoEventData)
 {
-	SelfTestEngine::InvokeStatusCallback("CentrifugeTest::ST_Idle");
+	SelfTestEngine::InvokeStatusCallback("selftest/centrifuge/state", "CentrifugeTest::ST_Idle");
 
 	// Call base class Idle state
 	SelfTest::ST_Idle(data);	
@@ -65,7 +75,7 @@ STATE_DEFINE(CentrifugeTest, Idle, NoEventData)
 //------------------------------------------------------------------------------
 STATE_DEFINE(CentrifugeTest, StartTest, StartData)
 {
-	SelfTestEngine::InvokeStatusCallback("CentrifugeTest::ST_StartTest");
+	SelfTestEngine::InvokeStatusCallback("selftest/centrifuge/state", "CentrifugeTest::ST_StartTest");
 
 	// Register for timer callbacks 
 	m_pollTimer.Expired = MakeDelegate(this, &CentrifugeTest::Poll, SelfTestEngine::GetInstance().GetThread());
@@ -78,8 +88,8 @@ STATE_DEFINE(CentrifugeTest, StartTest, StartData)
 //------------------------------------------------------------------------------
 GUARD_DEFINE(CentrifugeTest, GuardStartTest, NoEventData)
 {
-	SelfTestEngine::InvokeStatusCallback("CentrifugeTest::GD_GuardStartTest");
-	if (m_speed == 0)
+	SelfTestEngine::InvokeStatusCallback("selftest/centrifuge/state", "CentrifugeTest::GD_GuardStartTest");
+	if (!m_stateData.Is<Spinning>())
 		return TRUE;	// Centrifuge stopped. OK to start test.
 	else
 		return FALSE;	// Centrifuge spinning. Can't start test.
@@ -90,7 +100,7 @@ GUARD_DEFINE(CentrifugeTest, GuardStartTest, NoEventData)
 //------------------------------------------------------------------------------
 STATE_DEFINE(CentrifugeTest, Acceleration, NoEventData)
 {
-	SelfTestEngine::InvokeStatusCallback("CentrifugeTest::ST_Acceleration");
+	SelfTestEngine::InvokeStatusCallback("selftest/centrifuge/state", "CentrifugeTest::ST_Acceleration");
 
 	// Start polling while waiting for centrifuge to ramp up to speed
 	m_pollTimer.Start(std::chrono::milliseconds(10));
@@ -101,11 +111,13 @@ STATE_DEFINE(CentrifugeTest, Acceleration, NoEventData)
 //------------------------------------------------------------------------------
 STATE_DEFINE(CentrifugeTest, WaitForAcceleration, NoEventData)
 {
+	Spinning& spinning = m_stateData.Ref<Spinning>();
+
 	std::ostringstream ss;
-	ss << "CentrifugeTest::ST_WaitForAcceleration : Speed is " << m_speed;
-	SelfTestEngine::InvokeStatusCallback(ss.str());
+	ss << "CentrifugeTest::ST_WaitForAcceleration : Speed is " << spinning.speed;
+	SelfTestEngine::InvokeStatusCallback("selftest/centrifuge/speed", ss.str());
 
-	if (++m_speed >= 5)
+	if (++spinning.speed >= 5)
 		InternalEvent(ST_DECELERATION);
 }
 
@@ -114,7 +126,7 @@ STATE_DEFINE(CentrifugeTest, WaitForAcceleration, NoEventData)
 //------------------------------------------------------------------------------
 EXIT_DEFINE(CentrifugeTest, ExitWaitForAcceleration)
 {
-	SelfTestEngine::InvokeStatusCallback("CentrifugeTest::EX_ExitWaitForAcceleration");
+	SelfTestEngine::InvokeStatusCallback("selftest/centrifuge/state", "CentrifugeTest::EX_ExitWaitForAcceleration");
 
 	// Acceleration over, stop polling
 	m_pollTimer.Stop();
@@ -125,7 +137,7 @@ EXIT_DEFINE(CentrifugeTest, ExitWaitForAcceleration)
 //------------------------------------------------------------------------------
 STATE_DEFINE(CentrifugeTest, Deceleration, NoEventData)
 {
-	SelfTestEngine::InvokeStatusCallback("CentrifugeTest::ST_Deceleration");
+	SelfTestEngine::InvokeStatusCallback("selftest/centrifuge/state", "CentrifugeTest::ST_Deceleration");
 
 	// Start polling while waiting for centrifuge to ramp down to 0
 	m_pollTimer.Start(std::chrono::milliseconds(10));
@@ -136,11 +148,13 @@ STATE_DEFINE(CentrifugeTest, Deceleration, NoEventData)
 //------------------------------------------------------------------------------
 STATE_DEFINE(CentrifugeTest, WaitForDeceleration, NoEventData)
 {
+	Spinning& spinning = m_stateData.Ref<Spinning>();
+
 	std::ostringstream ss;
-	ss << "CentrifugeTest::ST_WaitForDeceleration : Speed is " << m_speed;
-	SelfTestEngine::InvokeStatusCallback(ss.str());
+	ss << "CentrifugeTest::ST_WaitForDeceleration : Speed is " << spinning.speed;
+	SelfTestEngine::InvokeStatusCallback("selftest/centrifuge/speed", ss.str());
 
-	if (m_speed-- == 0)
+	if (spinning.speed-- == 0)
 		InternalEvent(ST_COMPLETED);
 }
 
@@ -149,7 +163,7 @@ STATE_DEFINE(CentrifugeTest, WaitForDeceleration, NoEventData)
 //------------------------------------------------------------------------------
 EXIT_DEFINE(CentrifugeTest, ExitWaitForDeceleration)
 {
-	SelfTestEngine::InvokeStatusCallback("CentrifugeTest::EX_ExitWaitForDeceleration");
+	SelfTestEngine::InvokeStatusCallback("selftest/centrifuge/state", "CentrifugeTest::EX_ExitWaitForDeceleration");
 
 	// Deceleration over, stop polling
 	m_pollTimer.Stop();
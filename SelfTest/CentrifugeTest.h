@@ -2,6 +2,8 @@
 #define _CENTRIFUGE_TEST_H
 
 #include "SelfTest.h"
+#include "StateVariant.h"
+#include "StatePublisher.h"
 #include "Timer.h"
 
 // @brief CentrifugeTest shows StateMachine features including state machine
@@ -13,14 +15,24 @@ public:
 	CentrifugeTest();
 	virtual void Start(const StartData* data);
 
+	// Fields published with the current state after each state engine run
+	struct Status
+	{
+		INT speed;
+	};
+
+	// Read the latest published state and speed. Lock-free; may be called from
+	// any thread.
+	PublishedState<Status> ReadStatus() const { return m_status.Read(); }
+
 private:
 	void Poll();
 
+	void CaptureStatus(Status& status);
+
 	// Timer used to generate periodic callbacks to the Poll() event.
 	Timer m_pollTimer;
 
-	INT m_speed; 
-
 	// State enumeration order must match the order of state method entries
 	// in the state map.
 	enum States
@@ -34,6 +46,16 @@ private:
 		ST_MAX_STATES
 	};
 
+	// Data alive only while the centrifuge accelerates or decelerates
+	struct Spinning
+	{
+		enum { FIRST_STATE = ST_ACCELERATION, LAST_STATE = ST_WAIT_FOR_DECELERATION };
+		INT speed = 0;
+	};
+	StateVariant<Spinning> m_stateData;
+
+	StatePublisher<CentrifugeTest, Status, &CentrifugeTest::CaptureStatus> m_status;
+
 	// Define the state machine state functions with event data type
 	STATE_DECLARE(CentrifugeTest, 	Idle,						NoEventData)
 	STATE_DECLARE(CentrifugeTest, 	StartTest,					StartData)
@@ -28,7 +28,7 @@ void PressureTest::Start(const StartData* data)
 //------------------------------------------------------------------------------
 STATE_DEFINE(PressureTest, StartTest, StartData)
 {
-	SelfTestEngine::InvokeStatusCallback("PressureTest::ST_StartTest");
+	SelfTestEngine::InvokeStatusCallback("selftest/pressure/state", "PressureTest::ST_StartTest");
 	InternalEvent(ST_COMPLETED);
 }
 
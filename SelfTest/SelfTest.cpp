@@ -17,7 +17,10 @@ void SelfTest::Cancel()
 	// State machine base classes can't use a transition map, only the 
 	// most-derived state machine class within the hierarchy can. So external 
 	// events like this use the current state and call ExternalEvent()
-	// to invoke the state machine transition. 
+	// to invoke the state machine transition. Defer the event behind a 
+	// re-posted internal event chain so the current state is final.
+	if (DeferEvent(&SelfTest::Cancel))
+		return;
 	if (GetCurrentState() != ST_IDLE)
 		ExternalEvent(ST_FAILED);
 }
@@ -27,7 +30,7 @@ void SelfTest::Cancel()
 //------------------------------------------------------------------------------
 STATE_DEFINE(SelfTest, Idle, NoEventData)
 {
-	SelfTestEngine::InvokeStatusCallback("SelfTest::ST_Idle");
+	SelfTestEngine::InvokeStatusCallback("selftest/common/state", "SelfTest::ST_Idle");
 }
 
 //------------------------------------------------------------------------------
@@ -35,7 +38,7 @@ STATE_DEFINE(SelfTest, Idle, NoEventData)
 //------------------------------------------------------------------------------
 ENTRY_DEFINE(SelfTest, EntryIdle, NoEventData)
 {
-	SelfTestEngine::InvokeStatusCallback("SelfTest::EN_EntryIdle");
+	SelfTestEngine::InvokeStatusCallback("selftest/common/state", "SelfTest::EN_EntryIdle");
 }
 
 //------------------------------------------------------------------------------
@@ -43,7 +46,7 @@ ENTRY_DEFINE(SelfTest, EntryIdle, NoEventData)
 //------------------------------------------------------------------------------
 STATE_DEFINE(SelfTest, Completed, NoEventData)
 {
-	SelfTestEngine::InvokeStatusCallback("SelfTest::ST_Completed");
+	SelfTestEngine::InvokeStatusCallback("selftest/common/state", "SelfTest::ST_Completed");
 
 	if (CompletedCallback)
 		CompletedCallback();
@@ -56,7 +59,7 @@ STATE_DEFINE(SelfTest, Completed, NoEventData)
 //------------------------------------------------------------------------------
 STATE_DEFINE(SelfTest, Failed, NoEventData)
 {
-	SelfTestEngine::InvokeStatusCallback("SelfTest::ST_Failed");
+	SelfTestEngine::InvokeStatusCallback("selftest/common/state", "SelfTest::ST_Failed");
 
 	if (FailedCallback)
 		FailedCallback();
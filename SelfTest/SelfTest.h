@@ -10,6 +10,8 @@ using namespace DelegateLib;
 struct StartData : public EventData
 {
 	BOOL shortSelfTest = FALSE;		// TRUE for abbreviated self-tests 
+
+	SERIAL_FIELDS(shortSelfTest)
 };
 
 /// @brief SelfTest is a subclass state machine for other self-tests to 
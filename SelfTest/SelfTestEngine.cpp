@@ -1,6 +1,6 @@
 #include "SelfTestEngine.h"
 
-MulticastDelegateSafe<void(const SelfTestStatus&)> SelfTestEngine::StatusCallback;
+TopicRouter<void(const SelfTestStatus&)> SelfTestEngine::StatusTopics;
 
 //------------------------------------------------------------------------------
 // GetInstance
@@ -28,17 +28,14 @@ SelfTestEngine::SelfTestEngine() :
 //------------------------------------------------------------------------------
 // InvokeStatusCallback
 //------------------------------------------------------------------------------
-void SelfTestEngine::InvokeStatusCallback(std::string msg)
+void SelfTestEngine::InvokeStatusCallback(const char* topic, std::string msg)
 {
-	// Client(s) registered?
-	if (StatusCallback)
-	{
-		SelfTestStatus status;
-		status.message = msg;
+	SelfTestStatus status;
+	status.topic = topic;
+	status.message = msg;
 
-		// Callback registered client(s)
-		StatusCallback(status);
-	}
+	// Callback client(s) subscribed to a matching topic
+	StatusTopics.Publish(topic, status);
 }
 
 //------------------------------------------------------------------------------
@@ -85,7 +82,7 @@ STATE_DEFINE(SelfTestEngine, StartCentrifugeTest, StartData)
 {
 	m_startData = *data;
 
-	InvokeStatusCallback("SelfTestEngine::ST_CentrifugeTest");
+	InvokeStatusCallback("selftest/engine/state", "SelfTestEngine::ST_CentrifugeTest");
 	m_centrifugeTest.Start(&m_startData);
 }
 
@@ -94,7 +91,7 @@ STATE_DEFINE(SelfTestEngine, StartCentrifugeTest, StartData)
 //------------------------------------------------------------------------------
 STATE_DEFINE(SelfTestEngine, StartPressureTest, NoEventData)
 {
-	InvokeStatusCallback("SelfTestEngine::ST_PressureTest");
+	InvokeStatusCallback("selftest/engine/state", "SelfTestEngine::ST_PressureTest");
  	m_pressureTest.Start(&m_startData);
 }
 
@@ -11,6 +11,7 @@ using namespace DelegateLib;
 
 struct SelfTestStatus
 {
+	std::string topic;
 	std::string message;
 };
 
@@ -19,8 +20,9 @@ struct SelfTestStatus
 class SelfTestEngine : public SelfTest
 {
 public:
-	// Clients register for asynchronous self-test status callbacks
-	static MulticastDelegateSafe<void(const SelfTestStatus&)> StatusCallback;
+	// Clients subscribe for asynchronous self-test status callbacks by topic, 
+	// e.g. "selftest/#" for all status or "selftest/centrifuge/speed" 
+	static TopicRouter<void(const SelfTestStatus&)> StatusTopics;
 
 	// Singleton instance of SelfTestEngine
 	static SelfTestEngine& GetInstance();
@@ -29,7 +31,7 @@ public:
 	void Start(const StartData* data);
 
 	WorkerThread& GetThread() { return m_thread; }
-	static void InvokeStatusCallback(std::string msg);
+	static void InvokeStatusCallback(const char* topic, std::string msg);
 
 private:
 	SelfTestEngine();
@@ -0,0 +1,170 @@
+#include "EventBus.h"
+
+using namespace std;
+using namespace DelegateLib;
+
+/// @brief Message posted to a destination thread holding one published event
+/// and the subscribers on that thread.
+class EventBus::Message : public DelegateMsg
+{
+public:
+	Message(shared_ptr<IDelegateInvoker> invoker, shared_ptr<const Route> route,
+		size_t batch, shared_ptr<const EventData> data) :
+		DelegateMsg(invoker),
+		m_route(route),
+		m_batch(batch),
+		m_data(data)
+	{
+	}
+
+	/// Call each subscriber on the calling (destination) thread.
+	void Deliver() const
+	{
+		for (const Subscriber& subscriber : (*m_route)[m_batch].subscribers)
+			subscriber.handler(m_data.get());
+	}
+
+private:
+	/// Keeps the route snapshot alive until delivery completes.
+	shared_ptr<const Route> m_route;
+
+	/// The index of the destination thread batch within m_route.
+	size_t m_batch;
+
+	/// The event data shared by all destination threads.
+	shared_ptr<const EventData> m_data;
+};
+
+/// @brief Stateless invoker called by the destination thread to deliver a Message.
+class EventBus::Invoker : public IDelegateInvoker
+{
+public:
+	virtual bool Invoke(shared_ptr<DelegateMsg> msg)
+	{
+		auto busMsg = dynamic_pointer_cast<Message>(msg);
+		if (busMsg == nullptr)
+			return false;
+
+		busMsg->Deliver();
+		return true;
+	}
+};
+
+//----------------------------------------------------------------------------
+// Subscribe
+//----------------------------------------------------------------------------
+void EventBus::Subscribe(TypeId type, const StateMachine* machine, DelegateThread& thread,
+	INT machineId, Handler handler)
+{
+	ASSERT_TRUE(machine != NULL);
+
+	Subscriber subscriber = { machine, handler };
+
+	lock_guard<mutex> lock(m_lock);
+
+	// A machine specific subscriber also receives events published to all machines
+	AddSubscriber({ type, ALL_MACHINES }, thread, subscriber);
+	if (machineId != ALL_MACHINES)
+		AddSubscriber({ type, machineId }, thread, subscriber);
+}
+
+//----------------------------------------------------------------------------
+// AddSubscriber
+//----------------------------------------------------------------------------
+void EventBus::AddSubscriber(const Key& key, DelegateThread& thread, const Subscriber& subscriber)
+{
+	// Copy the existing route; in-flight events keep referencing the old one
+	auto route = make_shared<Route>();
+	auto it = m_routes.find(key);
+	if (it != m_routes.end())
+		*route = *it->second;
+
+	// Append to the batch for this thread, or start a new batch
+	bool added = false;
+	for (ThreadBatch& batch : *route)
+	{
+		if (batch.thread == &thread)
+		{
+			batch.subscribers.push_back(subscriber);
+			added = true;
+			break;
+		}
+	}
+	if (!added)
+		route->push_back({ &thread, { subscriber } });
+
+	m_routes[key] = route;
+}
+
+//----------------------------------------------------------------------------
+// Unsubscribe
+//----------------------------------------------------------------------------
+void EventBus::Unsubscribe(TypeId type, const StateMachine* machine)
+{
+	lock_guard<mutex> lock(m_lock);
+
+	for (auto it = m_routes.begin(); it != m_routes.end(); )
+	{
+		// Only the requested type, or every type if type is NULL
+		if (type != NULL && it->first.type != type)
+		{
+			++it;
+			continue;
+		}
+
+		// Rebuild the route without the machine's subscribers
+		auto route = make_shared<Route>();
+		BOOL removed = FALSE;
+		for (const ThreadBatch& batch : *it->second)
+		{
+			ThreadBatch remaining = { batch.thread, {} };
+			for (const Subscriber& subscriber : batch.subscribers)
+			{
+				if (subscriber.machine == machine)
+					removed = TRUE;
+				else
+					remaining.subscribers.push_back(subscriber);
+			}
+			if (!remaining.subscribers.empty())
+				route->push_back(remaining);
+		}
+
+		if (!removed)
+			++it;
+		else if (route->empty())
+			it = m_routes.erase(it);
+		else
+		{
+			it->second = route;
+			++it;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------
+// GetRoute
+//----------------------------------------------------------------------------
+shared_ptr<const EventBus::Route> EventBus::GetRoute(TypeId type, INT machineId)
+{
+	lock_guard<mutex> lock(m_lock);
+
+	auto it = m_routes.find({ type, machineId });
+	if (it == m_routes.end())
+		return nullptr;
+	return it->second;
+}
+
+//----------------------------------------------------------------------------
+// Dispatch
+//----------------------------------------------------------------------------
+void EventBus::Dispatch(const shared_ptr<const Route>& route, shared_ptr<const EventData> data)
+{
+	static const shared_ptr<IDelegateInvoker> invoker = make_shared<Invoker>();
+
+	// One message per destination thread regardless of its subscriber count
+	for (size_t i = 0; i < route->size(); i++)
+	{
+		auto msg = make_shared<Message>(invoker, route, i, data);
+		(*route)[i].thread->DispatchDelegate(msg);
+	}
+}
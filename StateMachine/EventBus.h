@@ -0,0 +1,146 @@
+#ifndef _EVENT_BUS_H
+#define _EVENT_BUS_H
+
+#include "StateMachine.h"
+#include "DelegateThread.h"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Delivers published events to state machine external event functions.
+/// Subscribers are keyed by event type and an optional machine id.
+///
+/// @details Each subscription names a state machine, one of its external event
+/// functions taking `const Data*` and the thread the machine runs on. Publish()
+/// finds the subscribers with a single hash lookup, copies the event once, and
+/// posts one message per destination thread. Each destination thread then calls
+/// every subscriber it owns in subscription order.
+///
+/// A subscription with a machine id receives events published to that id and
+/// events published to ALL_MACHINES. A subscription without a machine id only
+/// receives events published to ALL_MACHINES.
+///
+/// Subscribe(), Unsubscribe() and Publish() are thread-safe. Publish() only holds
+/// the bus lock while copying a reference to the subscriber list. Events already
+/// posted are still delivered after Unsubscribe(), so a machine must outlive any
+/// event published before it unsubscribed, as with an asynchronous delegate.
+class EventBus
+{
+public:
+	/// Machine id used to subscribe or publish without a specific machine.
+	enum { ALL_MACHINES = -1 };
+
+	EventBus() = default;
+
+	/// Subscribe a state machine external event function to an event type.
+	/// @param[in] machine - the state machine instance.
+	/// @param[in] func - the external event function called with the event.
+	/// @param[in] thread - the thread the state machine executes on.
+	/// @param[in] machineId - an optional id used to publish to this machine only.
+	template <class SM, class Data>
+	void Subscribe(SM* machine, void (SM::*func)(const Data*),
+		DelegateLib::DelegateThread& thread, INT machineId = ALL_MACHINES)
+	{
+		static_assert(std::is_base_of<StateMachine, SM>::value, "SM must derive from StateMachine");
+		static_assert(std::is_base_of<EventData, Data>::value, "Data must derive from EventData");
+
+		Subscribe(GetTypeId<Data>(), machine, thread, machineId,
+			[machine, func](const EventData* data) { (machine->*func)(static_cast<const Data*>(data)); });
+	}
+
+	/// Unsubscribe a state machine from one event type.
+	/// @param[in] machine - the state machine instance.
+	template <class Data>
+	void Unsubscribe(const StateMachine* machine) { Unsubscribe(GetTypeId<Data>(), machine); }
+
+	/// Unsubscribe a state machine from all event types.
+	/// @param[in] machine - the state machine instance.
+	void Unsubscribe(const StateMachine* machine) { Unsubscribe(NULL, machine); }
+
+	/// Publish an event. A copy of the event is delivered asynchronously to each
+	/// subscriber on its own thread.
+	/// @param[in] data - the event data to copy and deliver.
+	/// @param[in] machineId - the machine id to deliver to, or ALL_MACHINES.
+	/// @return TRUE if at least one subscriber was found.
+	template <class Data>
+	BOOL Publish(const Data& data, INT machineId = ALL_MACHINES)
+	{
+		static_assert(std::is_base_of<EventData, Data>::value, "Data must derive from EventData");
+
+		std::shared_ptr<const Route> route = GetRoute(GetTypeId<Data>(), machineId);
+		if (!route)
+			return FALSE;
+
+		Dispatch(route, std::make_shared<const Data>(data));
+		return TRUE;
+	}
+
+private:
+	EventBus(const EventBus&) = delete;
+	EventBus& operator=(const EventBus&) = delete;
+
+	/// Unique identifier for each event data type.
+	typedef const void* TypeId;
+
+	/// Get the identifier for an event data type. The address of a static
+	/// is unique per type and cheaper to hash than std::type_info.
+	template <class Data>
+	static TypeId GetTypeId()
+	{
+		static const char id = 0;
+		return &id;
+	}
+
+	typedef std::function<void(const EventData*)> Handler;
+
+	struct Subscriber
+	{
+		const StateMachine* machine;
+		Handler handler;
+	};
+
+	/// All subscribers of a route executing on the same thread.
+	struct ThreadBatch
+	{
+		DelegateLib::DelegateThread* thread;
+		std::vector<Subscriber> subscribers;
+	};
+
+	/// The subscribers for one key, grouped by thread. Routes are immutable once
+	/// published so that in-flight events can safely reference them.
+	typedef std::vector<ThreadBatch> Route;
+
+	struct Key
+	{
+		TypeId type;
+		INT machineId;
+
+		bool operator==(const Key& rhs) const { return type == rhs.type && machineId == rhs.machineId; }
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const
+		{
+			return std::hash<TypeId>()(key.type) ^ (size_t(key.machineId) * 0x9E3779B9u);
+		}
+	};
+
+	class Message;
+	class Invoker;
+
+	void Subscribe(TypeId type, const StateMachine* machine, DelegateLib::DelegateThread& thread,
+		INT machineId, Handler handler);
+	void Unsubscribe(TypeId type, const StateMachine* machine);
+	void AddSubscriber(const Key& key, DelegateLib::DelegateThread& thread, const Subscriber& subscriber);
+	std::shared_ptr<const Route> GetRoute(TypeId type, INT machineId);
+	static void Dispatch(const std::shared_ptr<const Route>& route, std::shared_ptr<const EventData> data);
+
+	std::mutex m_lock;
+	std::unordered_map<Key, std::shared_ptr<const Route>, KeyHash> m_routes;
+};
+
+#endif
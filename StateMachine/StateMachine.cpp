@@ -1,4 +1,18 @@
 #include "StateMachine.h"
+#include "StateProfiler.h"
+#include "StatePublisher.h"
+#include "StateVariant.h"
+#include "Tracer.h"
+#include "TransitionJournal.h"
+#include "DelegateLib.h"
+#include <chrono>
+#include <typeinfo>
+
+using namespace DelegateLib;
+
+// Name trace events by the dynamic type of the state machine or state object.
+// The typeid lookup only occurs while tracing is enabled.
+#define TRACE_NAME(obj) (Tracer::IsEnabled() ? typeid(*(obj)).name() : NULL)
 
 //----------------------------------------------------------------------------
 // StateMachine
@@ -8,16 +22,52 @@ StateMachine::StateMachine(BYTE maxStates, BYTE initialState) :
 	m_currentState(initialState),
 	m_newState(FALSE),
 	m_eventGenerated(FALSE),
-	m_pEventData(NULL)
+	m_pEventData(NULL),
+	m_journal(NULL),
+	m_journalId(0),
+	m_budgetThread(NULL),
+	m_budgetTransitions(0),
+	m_budgetTimeUs(0),
+	m_budgetTrips(0),
+	m_yielded(FALSE),
+	m_deferredRunning(FALSE),
+	m_parentState(CANNOT_HAPPEN),
+	m_stateVariant(NULL),
+	m_publisher(NULL)
 {
 	ASSERT_TRUE(MAX_STATES < EVENT_IGNORED);
 }  
 
+//----------------------------------------------------------------------------
+// SetStateVariant
+//----------------------------------------------------------------------------
+void StateMachine::SetStateVariant(StateVariantBase* stateVariant)
+{
+	m_stateVariant = stateVariant;
+	if (m_stateVariant != NULL)
+		m_stateVariant->Transition(m_currentState);
+}
+
+//----------------------------------------------------------------------------
+// SetStatePublisher
+//----------------------------------------------------------------------------
+void StateMachine::SetStatePublisher(StatePublisherBase* publisher)
+{
+	m_publisher = publisher;
+	if (m_publisher != NULL)
+		m_publisher->Publish(this, m_currentState);
+}
+
 //----------------------------------------------------------------------------
 // ExternalEvent
 //----------------------------------------------------------------------------
 void StateMachine::ExternalEvent(BYTE newState, const EventData* pData)
 {
+	// An event not deferred behind a re-posted internal event chain must not
+	// interleave with it, so finish the pending work before this event executes
+	if (IsEventPending())
+		CompletePendingEvents();
+
 	// If we are supposed to ignore this event
 	if (newState == EVENT_IGNORED)
 	{
@@ -63,30 +113,152 @@ void StateMachine::InternalEvent(BYTE newState, const EventData* pData)
 //----------------------------------------------------------------------------
 // StateEngine
 //----------------------------------------------------------------------------
-void StateMachine::StateEngine(void)
+void StateMachine::StateEngine(BOOL externalEvent, BOOL budget)
 {
+	m_yielded = FALSE;
+
 	const StateMapRow* pStateMap = GetStateMap();
 	if (pStateMap != NULL)
-		StateEngine(pStateMap);
+		StateEngine(pStateMap, externalEvent, budget);
 	else
 	{
 		const StateMapRowEx* pStateMapEx = GetStateMapEx();
 		if (pStateMapEx != NULL)
-			StateEngine(pStateMapEx);
+			StateEngine(pStateMapEx, externalEvent, budget);
 		else
 			ASSERT();
 	}
+
+	if (m_publisher != NULL)
+		m_publisher->Publish(this, m_currentState);
+}
+
+//----------------------------------------------------------------------------
+// GetBudgetTime
+//----------------------------------------------------------------------------
+std::uint64_t StateMachine::GetBudgetTime()
+{
+	return std::uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+//----------------------------------------------------------------------------
+// YieldIfOverBudget
+//----------------------------------------------------------------------------
+BOOL StateMachine::YieldIfOverBudget(UINT32 transitions, std::uint64_t startTime)
+{
+	// Nothing left to run, or no budget
+	if (!m_eventGenerated || m_budgetThread == NULL)
+		return FALSE;
+
+	BOOL exceeded = (m_budgetTransitions != 0 && transitions >= m_budgetTransitions);
+	if (!exceeded && m_budgetTimeUs != 0)
+		exceeded = (GetBudgetTime() - startTime >= m_budgetTimeUs);
+	if (!exceeded)
+		return FALSE;
+
+	// Leave the pending internal event in place and continue it behind the
+	// messages already queued to the thread
+	m_budgetTrips++;
+	m_yielded = TRUE;
+	PostResume();
+	return TRUE;
+}
+
+//----------------------------------------------------------------------------
+// PostResume
+//----------------------------------------------------------------------------
+void StateMachine::PostResume()
+{
+	MakeDelegate(this, &StateMachine::ResumeEngine, *m_budgetThread)();
+}
+
+//----------------------------------------------------------------------------
+// ResumeEngine
+//----------------------------------------------------------------------------
+void StateMachine::ResumeEngine()
+{
+	// Continue the re-posted chain, or else execute the oldest deferred event.
+	// Both may already be completed by an external event that was not deferred.
+	if (m_yielded)
+		StateEngine(FALSE, TRUE);
+	else if (!m_deferred.empty())
+		RunDeferredEvent();
+
+	// Execute the next deferred event behind the messages queued meanwhile. A 
+	// chain that yielded again is already re-posted.
+	if (!m_yielded && !m_deferred.empty())
+		PostResume();
+}
+
+//----------------------------------------------------------------------------
+// RunDeferredEvent
+//----------------------------------------------------------------------------
+void StateMachine::RunDeferredEvent()
+{
+	std::function<void()> event = std::move(m_deferred.front());
+	m_deferred.pop_front();
+
+	// The event is no longer pending behind the remaining deferred events
+	BOOL running = m_deferredRunning;
+	m_deferredRunning = TRUE;
+	event();
+	m_deferredRunning = running;
+}
+
+//----------------------------------------------------------------------------
+// CompletePendingEvents
+//----------------------------------------------------------------------------
+void StateMachine::CompletePendingEvents()
+{
+	while (IsEventPending())
+	{
+		if (m_yielded)
+			StateEngine(FALSE, FALSE);
+		else
+			RunDeferredEvent();
+	}
+}
+
+//----------------------------------------------------------------------------
+// ApplyTransition
+//----------------------------------------------------------------------------
+void StateMachine::ApplyTransition(const BYTE* transitions, BYTE transitionCount, BYTE parentState, const EventData* pData)
+{
+	// Transition from a parent state recorded by PARENT_TRANSITION
+	if (parentState != CANNOT_HAPPEN && 
+		m_currentState >= transitionCount && m_currentState < MAX_STATES)
+	{
+		ExternalEvent(parentState);
+		return;
+	}
+
+	ASSERT_TRUE(m_currentState < transitionCount);
+	ExternalEvent(transitions[m_currentState], pData);
+}
+
+//----------------------------------------------------------------------------
+// DeferTransition
+//----------------------------------------------------------------------------
+void StateMachine::DeferTransition(const BYTE* transitions, BYTE transitionCount, std::shared_ptr<const EventData> pData)
+{
+	// Look up the transition once the event executes, from the state the
+	// pending events leave
+	BYTE parentState = m_parentState;
+	m_parentState = CANNOT_HAPPEN;
+	m_deferred.push_back([this, transitions, transitionCount, parentState, pData] {
+		ApplyTransition(transitions, transitionCount, parentState, pData.get());
+	});
 }
 
 //----------------------------------------------------------------------------
 // StateEngine
 //----------------------------------------------------------------------------
-void StateMachine::StateEngine(const StateMapRow* const pStateMap)
+void StateMachine::StateEngine(const StateMapRow* const pStateMap, BOOL externalEvent, BOOL budget)
 {
-#if EXTERNAL_EVENT_NO_HEAP_DATA
-	BOOL externalEvent = TRUE;
-#endif
-	const EventData* pDataTemp = NULL;	
+	const EventData* pDataTemp = NULL;
+	UINT32 transitions = 0;
+	std::uint64_t startTime = (budget && m_budgetTimeUs != 0) ? GetBudgetTime() : 0;	
 
 	// While events are being generated keep executing states
 	while (m_eventGenerated)
@@ -106,12 +278,24 @@ void StateMachine::StateEngine(const StateMapRow* const pStateMap)
 		// Event used up, reset the flag
 		m_eventGenerated = FALSE;
 
+		// Record the transition
+		if (m_journal != NULL)
+			m_journal->Append(m_journalId, m_currentState, m_newState);
+
+		// Replace the state-local data when changing state
+		if (m_stateVariant != NULL && m_newState != m_currentState)
+			m_stateVariant->Transition(m_newState);
+
 		// Switch to the new current state
 		SetCurrentState(m_newState);
 
 		// Execute the state action passing in event data
 		ASSERT_TRUE(state != NULL);
-		state->InvokeStateAction(this, pDataTemp);
+		{
+			TraceSpan span(TRACE_NAME(state), "state", true, TRACE_NAME(this), m_currentState);
+			StateSample sample(this, state);
+			state->InvokeStateAction(this, pDataTemp);
+		}
 
 		// If event data was used, then delete it
 #if EXTERNAL_EVENT_NO_HEAP_DATA
@@ -129,18 +313,21 @@ void StateMachine::StateEngine(const StateMapRow* const pStateMap)
 			pDataTemp = NULL;
 		}
 #endif
+
+		// Yield the thread if this dispatch exceeded its run budget
+		if (budget && YieldIfOverBudget(++transitions, startTime))
+			break;
 	}
 }
 
 //----------------------------------------------------------------------------
 // StateEngine
 //----------------------------------------------------------------------------
-void StateMachine::StateEngine(const StateMapRowEx* const pStateMapEx)
+void StateMachine::StateEngine(const StateMapRowEx* const pStateMapEx, BOOL externalEvent, BOOL budget)
 {
-#if EXTERNAL_EVENT_NO_HEAP_DATA
-	BOOL externalEvent = TRUE;
-#endif
 	const EventData* pDataTemp = NULL;
+	UINT32 transitions = 0;
+	std::uint64_t startTime = (budget && m_budgetTimeUs != 0) ? GetBudgetTime() : 0;
 
 	// While events are being generated keep executing states
 	while (m_eventGenerated)
@@ -166,7 +353,10 @@ void StateMachine::StateEngine(const StateMapRowEx* const pStateMapEx)
 		// Execute the guard condition
 		BOOL guardResult = TRUE;
 		if (guard != NULL)
+		{
+			TraceSpan span(TRACE_NAME(guard), "guard", true, TRACE_NAME(this), m_newState);
 			guardResult = guard->InvokeGuardCondition(this, pDataTemp);
+		}
 
 		// If the guard condition succeeds
 		if (guardResult == TRUE)
@@ -176,21 +366,37 @@ void StateMachine::StateEngine(const StateMapRowEx* const pStateMapEx)
 			{
 				// Execute the state exit action on current state before switching to new state
 				if (exit != NULL)
+				{
+					TraceSpan span(TRACE_NAME(exit), "exit", true, TRACE_NAME(this), m_currentState);
 					exit->InvokeExitAction(this);
+				}
+
+				// Replace the state-local data between the exit and entry actions
+				if (m_stateVariant != NULL)
+					m_stateVariant->Transition(m_newState);
 
 				// Execute the state entry action on the new state
 				if (entry != NULL)
+				{
+					TraceSpan span(TRACE_NAME(entry), "entry", true, TRACE_NAME(this), m_newState);
 					entry->InvokeEntryAction(this, pDataTemp);
+				}
 
 				// Ensure exit/entry actions didn't call InternalEvent by accident 
 				ASSERT_TRUE(m_eventGenerated == FALSE);
 			}
 
+			// Record the transition
+			if (m_journal != NULL)
+				m_journal->Append(m_journalId, m_currentState, m_newState);
+
 			// Switch to the new current state
 			SetCurrentState(m_newState);
 
 			// Execute the state action passing in event data
 			ASSERT_TRUE(state != NULL);
+			TraceSpan span(TRACE_NAME(state), "state", true, TRACE_NAME(this), m_currentState);
+			StateSample sample(this, state);
 			state->InvokeStateAction(this, pDataTemp);
 		}
 
@@ -210,6 +416,13 @@ void StateMachine::StateEngine(const StateMapRowEx* const pStateMapEx)
 			pDataTemp = NULL;
 		}
 #endif
+
+		// Yield the thread if this dispatch exceeded its run budget. A transition
+		// rejected by its guard executes no action and is not counted.
+		if (guardResult == TRUE)
+			transitions++;
+		if (budget && YieldIfOverBudget(transitions, startTime))
+			break;
 	}
 }
 
@@ -4,6 +4,11 @@
 #include "DataTypes.h"
 #include <stdio.h>
 #include <typeinfo>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
 #include "Fault.h"
 
 // If EXTERNAL_EVENT_NO_HEAP_DATA is defined it changes how a client sends data to the
@@ -32,6 +37,13 @@ public:
 typedef EventData NoEventData;
 
 class StateMachine;
+class TransitionJournal;
+class StateVariantBase;
+class StatePublisherBase;
+
+namespace DelegateLib {
+	class DelegateThread;
+}
 
 /// @brief Abstract state base class that all states inherit from.
 class StateBase
@@ -192,6 +204,40 @@ public:
 	/// Gets the maximum number of state machine states.
 	/// @return The maximum state machine states. 
 	BYTE GetMaxStates() { return MAX_STATES; }
+
+	/// Record every state transition of this instance into a journal. Call before
+	/// the first event is generated.
+	/// @param[in] journal - the journal, or NULL to stop recording.
+	/// @param[in] machineId - the identifier stored with each journal record.
+	void SetJournal(TransitionJournal* journal, UINT32 machineId) 
+	{ 
+		m_journal = journal; 
+		m_journalId = machineId; 
+	}
+
+	/// Bound the work done by one external event. Once the event and the internal
+	/// events it generates have executed maxTransitions state actions, or run for
+	/// maxTimeUs microseconds, the remaining chain is re-posted to thread and
+	/// resumed after messages already queued there. Another external event arriving
+	/// first is deferred until the remaining chain completes, then executes under
+	/// its own budget; see TransitionEvent() and DeferEvent(). Call before the first 
+	/// event is generated. The instance must outlive any re-posted chain, as with 
+	/// any async delegate bound to it.
+	/// @param[in] thread - the thread this instance executes on, or NULL to always
+	/// run to completion.
+	/// @param[in] maxTransitions - the state action limit per dispatch, or 0 for none.
+	/// @param[in] maxTimeUs - the time limit per dispatch, or 0 for none.
+	void SetRunBudget(DelegateLib::DelegateThread* thread, UINT32 maxTransitions, UINT32 maxTimeUs = 0)
+	{
+		m_budgetThread = thread;
+		m_budgetTransitions = maxTransitions;
+		m_budgetTimeUs = maxTimeUs;
+	}
+
+	/// Gets the number of times the run budget was exceeded and the remaining
+	/// event chain re-posted.
+	/// @return The budget trip count.
+	UINT32 GetBudgetTripCount() const { return m_budgetTrips; }
 	
 protected:
 	/// External state machine event.
@@ -204,6 +250,71 @@ protected:
 	/// @param[in] newState - the state machine state to transition to.
 	/// @param[in] pData - the event data sent to the state.
 	void InternalEvent(BYTE newState, const EventData* pData = NULL);
+
+	/// Execute the external event selected by a transition map for the current 
+	/// state. Called by END_TRANSITION_MAP. If an internal event chain re-posted by
+	/// the run budget, or an event deferred behind one, is pending, the event is 
+	/// deferred until they complete. The event data is then copied, since the 
+	/// caller owns it.
+	/// @param[in] transitions - the new state for each current state.
+	/// @param[in] transitionCount - the number of transitions.
+	/// @param[in] pData - the event data sent to the state.
+	template <class Data>
+	void TransitionEvent(const BYTE* transitions, BYTE transitionCount, const Data* pData)
+	{
+		if (!IsEventPending())
+			ApplyTransition(transitions, transitionCount, CANNOT_HAPPEN, pData);
+		else
+#if EXTERNAL_EVENT_NO_HEAP_DATA
+			DeferTransition(transitions, transitionCount, 
+				std::shared_ptr<const EventData>(pData ? new Data(*pData) : NULL));
+#else
+			DeferTransition(transitions, transitionCount, 
+				std::shared_ptr<const EventData>(pData, [](const EventData*) { }));
+#endif
+	}
+	void TransitionEvent(const BYTE* transitions, BYTE transitionCount, std::nullptr_t)
+	{
+		TransitionEvent(transitions, transitionCount, (const EventData*)NULL);
+	}
+
+	/// Defer an external event function that reads GetCurrentState() directly 
+	/// while an internal event chain re-posted by the run budget, or an event 
+	/// deferred behind one, is pending. The function is called again once they 
+	/// complete.
+	/// @param[in] event - the external event function.
+	/// @return TRUE if the event is deferred and the caller must return.
+	template <class SM>
+	BOOL DeferEvent(void (SM::*event)())
+	{
+		if (!IsEventPending())
+			return FALSE;
+		SM* sm = static_cast<SM*>(this);
+		m_deferred.push_back([sm, event] { (sm->*event)(); });
+		return TRUE;
+	}
+
+	/// Record the parent state transition of a pending event for the transition
+	/// map that follows. Called by PARENT_TRANSITION.
+	/// @param[in] parentState - the state to transition to from a parent state.
+	void SetParentTransition(BYTE parentState) { m_parentState = parentState; }
+
+	/// Gets whether an external event must be deferred.
+	/// @return TRUE if a re-posted chain, or an event deferred behind one, is pending.
+	BOOL IsEventPending() const { return m_yielded || (!m_deferred.empty() && !m_deferredRunning); }
+
+	/// Register state-local data constructed and destroyed as states change. 
+	/// Typically called by the derived class constructor. The data of the 
+	/// current state is constructed immediately.
+	/// @param[in] stateVariant - the state-local data, usually a StateVariant member.
+	void SetStateVariant(StateVariantBase* stateVariant);
+
+	/// Publish the current state and selected fields at the end of each state 
+	/// engine run for lock-free observation from other threads. Typically called
+	/// by the derived class constructor. The current state is published immediately.
+	/// @param[in] publisher - the publisher, usually a StatePublisher member, or
+	/// NULL to stop publishing.
+	void SetStatePublisher(StatePublisherBase* publisher);
 	
 private:
 	/// The maximum number of state machine states.
@@ -221,6 +332,34 @@ private:
 	/// The state event data pointer.
 	const EventData* m_pEventData;
 
+	/// The optional transition journal and this instance's journal identifier.
+	TransitionJournal* m_journal;
+	UINT32 m_journalId;
+
+	/// The optional run budget; see SetRunBudget().
+	DelegateLib::DelegateThread* m_budgetThread;
+	UINT32 m_budgetTransitions;
+	UINT32 m_budgetTimeUs;
+	UINT32 m_budgetTrips;
+
+	/// Set to TRUE while an internal event chain is re-posted and not yet resumed.
+	BOOL m_yielded;
+
+	/// External events deferred behind a re-posted chain, oldest first. Set 
+	/// m_deferredRunning while one executes.
+	std::deque<std::function<void()>> m_deferred;
+	BOOL m_deferredRunning;
+
+	/// The parent state transition recorded by PARENT_TRANSITION while an event
+	/// is pending, or CANNOT_HAPPEN.
+	BYTE m_parentState;
+
+	/// The optional state-local data.
+	StateVariantBase* m_stateVariant;
+
+	/// The optional published state.
+	StatePublisherBase* m_publisher;
+
 	/// Gets the state map as defined in the derived class. The BEGIN_STATE_MAP,
 	/// STATE_MAP_ENTRY and END_STATE_MAP macros are used to assist in creating the
 	/// map. A state machine only needs to return a state map using either GetStateMap()  
@@ -243,9 +382,49 @@ private:
 
 	/// State machine engine that executes the external event and, optionally, all 
 	/// internal events generated during state execution.
-	void StateEngine(void); 	
-	void StateEngine(const StateMapRow* const pStateMap);
-	void StateEngine(const StateMapRowEx* const pStateMapEx);
+	/// @param[in] externalEvent - TRUE if the pending event is an external event;
+	/// FALSE if resuming an internal event chain.
+	/// @param[in] budget - TRUE to yield once the run budget is exceeded.
+	void StateEngine(BOOL externalEvent = TRUE, BOOL budget = TRUE); 	
+	void StateEngine(const StateMapRow* const pStateMap, BOOL externalEvent, BOOL budget);
+	void StateEngine(const StateMapRowEx* const pStateMapEx, BOOL externalEvent, BOOL budget);
+
+	/// Check the run budget after a state action. If exceeded, re-post the pending 
+	/// internal event to the budget thread.
+	/// @param[in] transitions - the state actions executed by this dispatch.
+	/// @param[in] startTime - the dispatch start time in microseconds.
+	/// @return TRUE if the state engine must return.
+	BOOL YieldIfOverBudget(UINT32 transitions, std::uint64_t startTime);
+
+	/// Get the run budget clock in microseconds.
+	static std::uint64_t GetBudgetTime();
+
+	/// Resume an internal event chain posted by YieldIfOverBudget(), or once the
+	/// chain completes execute the next deferred external event.
+	void ResumeEngine();
+
+	/// Post ResumeEngine() to the budget thread.
+	void PostResume();
+
+	/// Execute the oldest deferred external event.
+	void RunDeferredEvent();
+
+	/// Complete the re-posted chain and deferred events without a run budget. 
+	/// Called by an external event that was not deferred.
+	void CompletePendingEvents();
+
+	/// Execute the external event selected by a transition map.
+	/// @param[in] transitions - the new state for each current state.
+	/// @param[in] transitionCount - the number of transitions.
+	/// @param[in] parentState - the PARENT_TRANSITION state, or CANNOT_HAPPEN.
+	/// @param[in] pData - the event data sent to the state.
+	void ApplyTransition(const BYTE* transitions, BYTE transitionCount, BYTE parentState, const EventData* pData);
+
+	/// Defer the external event selected by a transition map.
+	/// @param[in] transitions - the new state for each current state.
+	/// @param[in] transitionCount - the number of transitions.
+	/// @param[in] pData - the event data, owned by the deferred event.
+	void DeferTransition(const BYTE* transitions, BYTE transitionCount, std::shared_ptr<const EventData> pData);
 };
 
 #define STATE_DECLARE(stateMachine, stateName, eventData) \
@@ -284,12 +463,13 @@ private:
 
 #define END_TRANSITION_MAP(data) \
     };\
-	ASSERT_TRUE(GetCurrentState() < ST_MAX_STATES); \
-    ExternalEvent(TRANSITIONS[GetCurrentState()], data); \
+    TransitionEvent(TRANSITIONS, ST_MAX_STATES, data); \
 	C_ASSERT((sizeof(TRANSITIONS)/sizeof(BYTE)) == ST_MAX_STATES); 
 
 #define PARENT_TRANSITION(state) \
-	if (GetCurrentState() >= ST_MAX_STATES && \
+	if (IsEventPending()) \
+		SetParentTransition(state); \
+	else if (GetCurrentState() >= ST_MAX_STATES && \
 		GetCurrentState() < GetMaxStates()) { \
 		ExternalEvent(state); \
 		return; }
@@ -0,0 +1,296 @@
+#include "StateMachineRegistry.h"
+#include <thread>
+
+using namespace std;
+using namespace DelegateLib;
+
+/// Initial slots per shard table. Always a power of two.
+static const UINT32 INITIAL_CAPACITY = 16;
+
+//----------------------------------------------------------------------------
+// GetReaderSlot
+//----------------------------------------------------------------------------
+static UINT32 GetReaderSlot()
+{
+	// Each thread is given a sequential index on first use to spread readers
+	// over the counter cache lines
+	static atomic<UINT32> nextThreadIndex(0);
+	static thread_local UINT32 threadIndex = nextThreadIndex.fetch_add(1, memory_order_relaxed);
+	return threadIndex;
+}
+
+//----------------------------------------------------------------------------
+// ReadGuard
+//----------------------------------------------------------------------------
+StateMachineRegistry::ReadGuard::ReadGuard(const StateMachineRegistry& registry) :
+	m_count(Enter(registry))
+{
+}
+
+//----------------------------------------------------------------------------
+// ~ReadGuard
+//----------------------------------------------------------------------------
+StateMachineRegistry::ReadGuard::~ReadGuard()
+{
+	m_count.fetch_sub(1, memory_order_release);
+}
+
+//----------------------------------------------------------------------------
+// Enter
+//----------------------------------------------------------------------------
+atomic<uint64_t>& StateMachineRegistry::ReadGuard::Enter(const StateMachineRegistry& registry)
+{
+	ReaderSlot& slot = registry.m_readers[GetReaderSlot() % READER_SLOTS];
+	while (1)
+	{
+		// Count this reader against the current parity. If the parity flipped
+		// before the count was visible, Synchronize() may not wait for it, so
+		// back out and retry against the new parity.
+		UINT32 epoch = registry.m_epoch.load(memory_order_seq_cst);
+		atomic<uint64_t>& count = slot.count[epoch & 1];
+		count.fetch_add(1, memory_order_seq_cst);
+		if (registry.m_epoch.load(memory_order_seq_cst) == epoch)
+			return count;
+		count.fetch_sub(1, memory_order_release);
+	}
+}
+
+//----------------------------------------------------------------------------
+// StateMachineRegistry
+//----------------------------------------------------------------------------
+StateMachineRegistry::StateMachineRegistry(UINT32 shardCount) :
+	m_shardCount(1),
+	m_epoch(0)
+{
+	while (m_shardCount < shardCount && m_shardCount < (1u << 24))
+		m_shardCount <<= 1;
+	m_shards.reset(new Shard[m_shardCount]);
+	for (UINT32 s = 0; s < m_shardCount; s++)
+		m_shards[s].table.store(CreateTable(INITIAL_CAPACITY));
+
+	for (UINT32 i = 0; i < READER_SLOTS; i++)
+	{
+		m_readers[i].count[0].store(0);
+		m_readers[i].count[1].store(0);
+	}
+}
+
+//----------------------------------------------------------------------------
+// ~StateMachineRegistry
+//----------------------------------------------------------------------------
+StateMachineRegistry::~StateMachineRegistry()
+{
+	Synchronize();
+	for (UINT32 s = 0; s < m_shardCount; s++)
+	{
+		Table* table = m_shards[s].table.load();
+		for (UINT32 i = 0; i <= table->mask; i++)
+		{
+			uint64_t key = table->slots[i].key.load();
+			if (key != EMPTY && key != DELETED)
+				delete table->slots[i].entry.load();
+		}
+		delete table;
+	}
+}
+
+//----------------------------------------------------------------------------
+// Hash
+//----------------------------------------------------------------------------
+uint64_t StateMachineRegistry::Hash(UINT32 id)
+{
+	// Fibonacci hashing, folded so the low bits also depend on every id bit
+	uint64_t hash = uint64_t(id) * 0x9E3779B97F4A7C15ull;
+	return hash ^ (hash >> 29);
+}
+
+//----------------------------------------------------------------------------
+// CreateTable
+//----------------------------------------------------------------------------
+StateMachineRegistry::Table* StateMachineRegistry::CreateTable(UINT32 capacity)
+{
+	Table* table = new Table();
+	table->mask = capacity - 1;
+	table->used = 0;
+	table->count = 0;
+	table->slots.reset(new Slot[capacity]);
+	for (UINT32 i = 0; i < capacity; i++)
+	{
+		table->slots[i].key.store(EMPTY, memory_order_relaxed);
+		table->slots[i].entry.store(NULL, memory_order_relaxed);
+	}
+	return table;
+}
+
+//----------------------------------------------------------------------------
+// Insert
+//----------------------------------------------------------------------------
+void StateMachineRegistry::Insert(Table* table, uint64_t key, const Entry* entry)
+{
+	UINT32 i = UINT32(Hash(UINT32(key - 1))) & table->mask;
+	while (table->slots[i].key.load(memory_order_relaxed) != EMPTY)
+		i = (i + 1) & table->mask;
+
+	// Publish the entry before the key so a reader matching the key sees it
+	table->slots[i].entry.store(entry, memory_order_relaxed);
+	table->slots[i].key.store(key, memory_order_release);
+	table->used++;
+	table->count++;
+}
+
+//----------------------------------------------------------------------------
+// Add
+//----------------------------------------------------------------------------
+BOOL StateMachineRegistry::Add(UINT32 id, StateMachine* machine, DelegateThread* thread)
+{
+	ASSERT_TRUE(machine != NULL);
+
+	uint64_t key = uint64_t(id) + 1;
+	Shard& shard = GetShard(Hash(id));
+	lock_guard<mutex> lock(shard.lock);
+
+	if (FindEntry(id) != NULL)
+		return FALSE;
+
+	// Keep at most half the slots used, counting deleted slots. Rebuild into a
+	// new table, larger only if the live count requires it, and retire the old.
+	Table* table = shard.table.load(memory_order_relaxed);
+	if ((table->used + 1) * 2 > table->mask + 1)
+	{
+		UINT32 capacity = table->mask + 1;
+		while ((table->count + 1) * 4 > capacity)
+			capacity <<= 1;
+
+		Table* rebuilt = CreateTable(capacity);
+		for (UINT32 i = 0; i <= table->mask; i++)
+		{
+			uint64_t slotKey = table->slots[i].key.load(memory_order_relaxed);
+			if (slotKey != EMPTY && slotKey != DELETED)
+				Insert(rebuilt, slotKey, table->slots[i].entry.load(memory_order_relaxed));
+		}
+		shard.table.store(rebuilt, memory_order_release);
+
+		lock_guard<mutex> retireLock(m_retireLock);
+		m_retiredTables.push_back(table);
+		table = rebuilt;
+	}
+
+	Insert(table, key, new Entry{ machine, thread });
+	return TRUE;
+}
+
+//----------------------------------------------------------------------------
+// Remove
+//----------------------------------------------------------------------------
+BOOL StateMachineRegistry::Remove(UINT32 id, BOOL wait)
+{
+	uint64_t key = uint64_t(id) + 1;
+	Shard& shard = GetShard(Hash(id));
+	{
+		lock_guard<mutex> lock(shard.lock);
+
+		Table* table = shard.table.load(memory_order_relaxed);
+		UINT32 i = UINT32(Hash(id)) & table->mask;
+		while (1)
+		{
+			uint64_t slotKey = table->slots[i].key.load(memory_order_relaxed);
+			if (slotKey == EMPTY)
+				return FALSE;
+			if (slotKey == key)
+				break;
+			i = (i + 1) & table->mask;
+		}
+
+		// Unlink; the entry stays valid for readers that already matched the key
+		table->slots[i].key.store(DELETED, memory_order_release);
+		table->count--;
+
+		lock_guard<mutex> retireLock(m_retireLock);
+		m_retiredEntries.push_back(table->slots[i].entry.load(memory_order_relaxed));
+	}
+
+	if (wait)
+		Synchronize();
+	return TRUE;
+}
+
+//----------------------------------------------------------------------------
+// Synchronize
+//----------------------------------------------------------------------------
+void StateMachineRegistry::Synchronize()
+{
+	lock_guard<mutex> syncLock(m_syncLock);
+
+	// Everything retired so far was unlinked before the parity flip below
+	vector<const Entry*> entries;
+	vector<Table*> tables;
+	{
+		lock_guard<mutex> retireLock(m_retireLock);
+		entries.swap(m_retiredEntries);
+		tables.swap(m_retiredTables);
+	}
+
+	// Flip the parity; new readers count against the other counters. Wait for
+	// readers counted against the old parity to leave.
+	UINT32 epoch = m_epoch.fetch_add(1, memory_order_seq_cst);
+	for (UINT32 i = 0; i < READER_SLOTS; i++)
+	{
+		while (m_readers[i].count[epoch & 1].load(memory_order_acquire) != 0)
+			this_thread::yield();
+	}
+
+	for (const Entry* entry : entries)
+		delete entry;
+	for (Table* table : tables)
+		delete table;
+}
+
+//----------------------------------------------------------------------------
+// Find
+//----------------------------------------------------------------------------
+BOOL StateMachineRegistry::Find(UINT32 id, Entry& entry) const
+{
+	ReadGuard guard(*this);
+	const Entry* found = FindEntry(id);
+	if (found == NULL)
+		return FALSE;
+	entry = *found;
+	return TRUE;
+}
+
+//----------------------------------------------------------------------------
+// FindEntry
+//----------------------------------------------------------------------------
+const StateMachineRegistry::Entry* StateMachineRegistry::FindEntry(UINT32 id) const
+{
+	uint64_t key = uint64_t(id) + 1;
+	uint64_t hash = Hash(id);
+	const Table* table = GetShard(hash).table.load(memory_order_acquire);
+
+	// Linear probe until the key or an empty slot. Tables are at most half
+	// full so an empty slot always exists.
+	UINT32 i = UINT32(hash) & table->mask;
+	while (1)
+	{
+		uint64_t slotKey = table->slots[i].key.load(memory_order_acquire);
+		if (slotKey == key)
+			return table->slots[i].entry.load(memory_order_acquire);
+		if (slotKey == EMPTY)
+			return NULL;
+		i = (i + 1) & table->mask;
+	}
+}
+
+//----------------------------------------------------------------------------
+// GetCount
+//----------------------------------------------------------------------------
+size_t StateMachineRegistry::GetCount() const
+{
+	size_t count = 0;
+	for (UINT32 s = 0; s < m_shardCount; s++)
+	{
+		lock_guard<mutex> lock(m_shards[s].lock);
+		count += m_shards[s].table.load(memory_order_relaxed)->count;
+	}
+	return count;
+}
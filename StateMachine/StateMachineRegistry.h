@@ -0,0 +1,198 @@
+#ifndef _STATE_MACHINE_REGISTRY_H
+#define _STATE_MACHINE_REGISTRY_H
+
+#include "StateMachine.h"
+#include "DelegateLib.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// @brief Concurrent map of machine ids to state machines and their owning
+/// threads, used to route inbound events to one of many machines.
+///
+/// @details Ids are spread over independently locked shards. Each shard is an
+/// open addressing table that readers probe without taking any lock. Writers
+/// (Add, Remove) lock only their shard and never modify an entry or table that
+/// a reader may be using; replaced tables and removed entries are retired and
+/// freed after an RCU-style grace period, once every reader that could have
+/// seen them has finished.
+///
+/// Readers announce themselves by incrementing one of two counters chosen by
+/// the current grace period parity. Synchronize() flips the parity and waits
+/// for the previous parity counters to drain. The counters are spread over
+/// cache lines so that readers on different threads rarely share one.
+///
+/// Find(), Dispatch(), Invoke() and ForEach() callbacks must not call Remove()
+/// with wait set or Synchronize(); the grace period would wait on itself.
+class StateMachineRegistry
+{
+public:
+	/// @brief A registered machine.
+	struct Entry
+	{
+		StateMachine* machine;
+		DelegateLib::DelegateThread* thread;	// NULL to invoke synchronously
+	};
+
+	/// Constructor
+	/// @param[in] shardCount - the number of shards, rounded up to a power of two.
+	StateMachineRegistry(UINT32 shardCount = 64);
+
+	/// Destructor. No other thread may be using the registry.
+	~StateMachineRegistry();
+
+	/// Register a machine.
+	/// @param[in] id - the unique machine id.
+	/// @param[in] machine - the state machine instance.
+	/// @param[in] thread - the thread the machine executes on, or NULL.
+	/// @return TRUE if added; FALSE if the id is already registered.
+	/// @post A table replaced to make room is freed by the next Synchronize().
+	BOOL Add(UINT32 id, StateMachine* machine, DelegateLib::DelegateThread* thread);
+
+	/// Unregister a machine.
+	/// @param[in] id - the machine id.
+	/// @param[in] wait - TRUE to wait until no reader can still be using the
+	/// entry. If FALSE, the entry is freed by a later Synchronize().
+	/// @return TRUE if the id was registered.
+	BOOL Remove(UINT32 id, BOOL wait = TRUE);
+
+	/// Wait for all current readers to finish, then free retired entries and tables.
+	void Synchronize();
+
+	/// Look up a machine. Lock-free.
+	/// @param[in] id - the machine id.
+	/// @param[out] entry - a copy of the registered entry.
+	/// @return TRUE if found.
+	BOOL Find(UINT32 id, Entry& entry) const;
+
+	/// Call func(const Entry&) for a machine while the entry is protected from
+	/// removal. Lock-free.
+	/// @return TRUE if found.
+	template <class Func>
+	BOOL Invoke(UINT32 id, Func func) const
+	{
+		ReadGuard guard(*this);
+		const Entry* entry = FindEntry(id);
+		if (entry == NULL)
+			return FALSE;
+		func(*entry);
+		return TRUE;
+	}
+
+	/// Send an external event to a machine. The external event function is invoked
+	/// asynchronously on the machine's thread with a copy of data, or directly if
+	/// the machine was registered without a thread.
+	/// @param[in] id - the machine id. The machine must be of type SM.
+	/// @param[in] func - the external event function.
+	/// @param[in] data - the event data.
+	/// @return TRUE if the machine was found.
+	template <class SM, class Data>
+	BOOL Dispatch(UINT32 id, void (SM::*func)(const Data*), const Data* data) const
+	{
+		return Invoke(id, [func, data](const Entry& entry) {
+			SM* machine = static_cast<SM*>(entry.machine);
+			if (entry.thread == NULL)
+				(machine->*func)(data);
+			else
+				DelegateLib::MakeDelegate(machine, func, *entry.thread)(data);
+		});
+	}
+
+	/// Call func(UINT32 id, const Entry&) for every registered machine. Machines
+	/// added or removed during iteration may or may not be visited. Lock-free.
+	template <class Func>
+	void ForEach(Func func) const
+	{
+		ReadGuard guard(*this);
+		for (UINT32 s = 0; s < m_shardCount; s++)
+		{
+			const Table* table = m_shards[s].table.load(std::memory_order_acquire);
+			for (UINT32 i = 0; i <= table->mask; i++)
+			{
+				std::uint64_t key = table->slots[i].key.load(std::memory_order_acquire);
+				if (key == EMPTY || key == DELETED)
+					continue;
+				const Entry* entry = table->slots[i].entry.load(std::memory_order_acquire);
+				func(UINT32(key - 1), *entry);
+			}
+		}
+	}
+
+	/// Get the number of registered machines.
+	size_t GetCount() const;
+
+private:
+	StateMachineRegistry(const StateMachineRegistry&) = delete;
+	StateMachineRegistry& operator=(const StateMachineRegistry&) = delete;
+
+	/// Slot key values. A registered id is stored as id + 1.
+	static const std::uint64_t EMPTY = 0;
+	static const std::uint64_t DELETED = ~std::uint64_t(0);
+
+	/// Number of reader counter pairs.
+	static const UINT32 READER_SLOTS = 16;
+
+	struct Slot
+	{
+		std::atomic<std::uint64_t> key;
+		std::atomic<const Entry*> entry;
+	};
+
+	/// An immutable-size open addressing table. Deleted slots are never reused
+	/// so a reader never sees a key paired with another id's entry.
+	struct Table
+	{
+		UINT32 mask;
+		UINT32 used;	// Slots holding a key or DELETED
+		UINT32 count;	// Slots holding a key
+		std::unique_ptr<Slot[]> slots;
+	};
+
+	struct alignas(64) Shard
+	{
+		std::atomic<Table*> table;
+		std::mutex lock;
+	};
+
+	struct alignas(64) ReaderSlot
+	{
+		std::atomic<std::uint64_t> count[2];
+	};
+
+	/// @brief RAII read-side critical section.
+	class ReadGuard
+	{
+	public:
+		ReadGuard(const StateMachineRegistry& registry);
+		~ReadGuard();
+	private:
+		std::atomic<std::uint64_t>& m_count;
+		static std::atomic<std::uint64_t>& Enter(const StateMachineRegistry& registry);
+	};
+
+	static std::uint64_t Hash(UINT32 id);
+	static Table* CreateTable(UINT32 capacity);
+	static void Insert(Table* table, std::uint64_t key, const Entry* entry);
+
+	/// The hash high bits pick the shard; the low bits pick the slot.
+	Shard& GetShard(std::uint64_t hash) const { return m_shards[UINT32(hash >> 40) & (m_shardCount - 1)]; }
+	const Entry* FindEntry(UINT32 id) const;
+
+	UINT32 m_shardCount;
+	std::unique_ptr<Shard[]> m_shards;
+
+	mutable ReaderSlot m_readers[READER_SLOTS];
+	std::atomic<UINT32> m_epoch;
+
+	/// Entries and tables unlinked but possibly still in use by readers.
+	std::mutex m_retireLock;
+	std::vector<const Entry*> m_retiredEntries;
+	std::vector<Table*> m_retiredTables;
+
+	/// Serializes grace periods.
+	std::mutex m_syncLock;
+};
+
+#endif
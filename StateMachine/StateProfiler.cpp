@@ -0,0 +1,296 @@
+#include "StateProfiler.h"
+#include "StateMachine.h"
+#include "MetricsExporter.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+atomic<UINT32> StateProfiler::m_interval(0);
+
+/// Sample totals for one (machine type, state) pair.
+struct StateStats
+{
+	uint64_t samples = 0;
+	uint64_t totalNs = 0;
+	uint64_t maxNs = 0;
+	uint64_t estimatedNs = 0;	// Sum of each sample scaled by its interval
+};
+
+typedef pair<const type_info*, const type_info*> StateKey;
+
+struct StateKeyHash
+{
+	size_t operator()(const StateKey& key) const
+	{
+		return hash<const void*>()(key.first) ^ (hash<const void*>()(key.second) * 31);
+	}
+};
+
+/// Samples recorded by one thread. The lock is only contended by GetReport() and Reset().
+struct ThreadSamples
+{
+	mutex lock;
+	unordered_map<StateKey, StateStats, StateKeyHash> stats;
+};
+
+/// State action counts of one thread. Only the owning thread writes the counts,
+/// and it only takes the lock to add a pair, which GetStateCounts() excludes.
+struct ThreadCounts
+{
+	mutex lock;
+	unordered_map<StateKey, atomic<uint64_t>, StateKeyHash> counts;
+};
+
+//----------------------------------------------------------------------------
+// GetAllSamples
+//----------------------------------------------------------------------------
+static vector<shared_ptr<ThreadSamples>>& GetAllSamples(mutex*& lock)
+{
+	static mutex allLock;
+	static vector<shared_ptr<ThreadSamples>> all;
+	lock = &allLock;
+	return all;
+}
+
+//----------------------------------------------------------------------------
+// GetThreadSamples
+//----------------------------------------------------------------------------
+static ThreadSamples& GetThreadSamples()
+{
+	// Registered on the first sample and kept after thread exit for reporting
+	static thread_local shared_ptr<ThreadSamples> samples;
+	if (!samples)
+	{
+		samples = make_shared<ThreadSamples>();
+		mutex* lock;
+		auto& all = GetAllSamples(lock);
+		lock_guard<mutex> guard(*lock);
+		all.push_back(samples);
+	}
+	return *samples;
+}
+
+//----------------------------------------------------------------------------
+// GetAllCounts
+//----------------------------------------------------------------------------
+static vector<shared_ptr<ThreadCounts>>& GetAllCounts(mutex*& lock)
+{
+	static mutex allLock;
+	static vector<shared_ptr<ThreadCounts>> all;
+	lock = &allLock;
+	return all;
+}
+
+//----------------------------------------------------------------------------
+// GetThreadCounts
+//----------------------------------------------------------------------------
+static ThreadCounts& GetThreadCounts()
+{
+	// Registered on the first state action and kept after thread exit
+	static thread_local shared_ptr<ThreadCounts> counts;
+	if (!counts)
+	{
+		counts = make_shared<ThreadCounts>();
+		mutex* lock;
+		auto& all = GetAllCounts(lock);
+		lock_guard<mutex> guard(*lock);
+		all.push_back(counts);
+	}
+	return *counts;
+}
+
+//----------------------------------------------------------------------------
+// MergeSamples
+//----------------------------------------------------------------------------
+static unordered_map<StateKey, StateStats, StateKeyHash> MergeSamples()
+{
+	unordered_map<StateKey, StateStats, StateKeyHash> merged;
+	mutex* lock;
+	auto& all = GetAllSamples(lock);
+	lock_guard<mutex> guard(*lock);
+	for (auto& samples : all)
+	{
+		lock_guard<mutex> samplesLock(samples->lock);
+		for (auto& it : samples->stats)
+		{
+			StateStats& stats = merged[it.first];
+			stats.samples += it.second.samples;
+			stats.totalNs += it.second.totalNs;
+			stats.maxNs = max(stats.maxNs, it.second.maxNs);
+			stats.estimatedNs += it.second.estimatedNs;
+		}
+	}
+	return merged;
+}
+
+//----------------------------------------------------------------------------
+// NextInterval
+//----------------------------------------------------------------------------
+UINT32 StateProfiler::NextInterval(UINT32 interval)
+{
+	// xorshift32; seeded per thread from its stack address
+	static thread_local UINT32 seed = UINT32(reinterpret_cast<uintptr_t>(&seed)) | 1;
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+
+	// Uniform in [1, 2N - 1] so the mean distance is N
+	if (interval <= 1)
+		return 1;
+	return 1 + seed % (2 * interval - 1);
+}
+
+//----------------------------------------------------------------------------
+// GetTime
+//----------------------------------------------------------------------------
+uint64_t StateProfiler::GetTime()
+{
+	// Never zero; StateSample uses zero to mean not sampled
+	return uint64_t(chrono::duration_cast<chrono::nanoseconds>(
+		chrono::steady_clock::now().time_since_epoch()).count()) | 1;
+}
+
+//----------------------------------------------------------------------------
+// Count
+//----------------------------------------------------------------------------
+void StateProfiler::Count(const type_info& machine, const type_info& state)
+{
+	ThreadCounts& counts = GetThreadCounts();
+	StateKey key(&machine, &state);
+	auto it = counts.counts.find(key);
+	if (it == counts.counts.end())
+	{
+		lock_guard<mutex> lock(counts.lock);
+		it = counts.counts.emplace(piecewise_construct, forward_as_tuple(key), forward_as_tuple(0)).first;
+	}
+
+	// Single writer, so a relaxed load and store suffice
+	it->second.store(it->second.load(memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+// Record
+//----------------------------------------------------------------------------
+void StateProfiler::Record(const type_info& machine, const type_info& state, uint64_t ns)
+{
+	UINT32 interval = GetSampleInterval();
+	ThreadSamples& samples = GetThreadSamples();
+	lock_guard<mutex> lock(samples.lock);
+
+	StateStats& stats = samples.stats[StateKey(&machine, &state)];
+	stats.samples++;
+	stats.totalNs += ns;
+	stats.maxNs = max(stats.maxNs, ns);
+	stats.estimatedNs += ns * (interval > 0 ? interval : 1);
+}
+
+//----------------------------------------------------------------------------
+// GetReport
+//----------------------------------------------------------------------------
+string StateProfiler::GetReport(size_t topN)
+{
+	unordered_map<StateKey, StateStats, StateKeyHash> merged = MergeSamples();
+
+	vector<pair<StateKey, StateStats>> sorted(merged.begin(), merged.end());
+	sort(sorted.begin(), sorted.end(), [](const pair<StateKey, StateStats>& a, const pair<StateKey, StateStats>& b) {
+		return a.second.estimatedNs > b.second.estimatedNs;
+	});
+
+	uint64_t estimatedTotal = 0;
+	for (auto& it : sorted)
+		estimatedTotal += it.second.estimatedNs;
+
+	string report;
+	char line[256];
+	snprintf(line, sizeof(line), "%-24s %-40s %10s %10s %10s %12s %6s\n",
+		"Machine", "State", "Samples", "Mean ns", "Max ns", "Est. ms", "%");
+	report += line;
+
+	for (size_t i = 0; i < sorted.size() && i < topN; i++)
+	{
+		const StateStats& stats = sorted[i].second;
+		snprintf(line, sizeof(line), "%-24s %-40s %10llu %10llu %10llu %12.3f %6.1f\n",
+			Tracer::GetTypeName(sorted[i].first.first->name()).c_str(),
+			Tracer::GetTypeName(sorted[i].first.second->name()).c_str(),
+			(unsigned long long)stats.samples,
+			(unsigned long long)(stats.totalNs / stats.samples),
+			(unsigned long long)stats.maxNs,
+			double(stats.estimatedNs) / 1e6,
+			estimatedTotal ? 100.0 * double(stats.estimatedNs) / double(estimatedTotal) : 0.0);
+		report += line;
+	}
+	return report;
+}
+
+//----------------------------------------------------------------------------
+// GetStateCounts
+//----------------------------------------------------------------------------
+void StateProfiler::GetStateCounts(vector<MetricsCounter>& counters)
+{
+	unordered_map<StateKey, uint64_t, StateKeyHash> merged;
+	{
+		mutex* lock;
+		auto& all = GetAllCounts(lock);
+		lock_guard<mutex> guard(*lock);
+		for (auto& counts : all)
+		{
+			lock_guard<mutex> countsLock(counts->lock);
+			for (auto& it : counts->counts)
+				merged[it.first] += it.second.load(memory_order_relaxed);
+		}
+	}
+
+	vector<pair<StateKey, uint64_t>> sorted(merged.begin(), merged.end());
+	sort(sorted.begin(), sorted.end(), [](const pair<StateKey, uint64_t>& a, const pair<StateKey, uint64_t>& b) {
+		return a.second > b.second;
+	});
+
+	for (auto& it : sorted)
+	{
+		MetricsCounter counter;
+		counter.name = Tracer::GetTypeName(it.first.first->name()) + "::" + Tracer::GetTypeName(it.first.second->name());
+		counter.value = it.second;
+		counters.push_back(counter);
+	}
+}
+
+//----------------------------------------------------------------------------
+// Reset
+//----------------------------------------------------------------------------
+void StateProfiler::Reset()
+{
+	mutex* lock;
+	auto& all = GetAllSamples(lock);
+	lock_guard<mutex> guard(*lock);
+	for (auto& samples : all)
+	{
+		lock_guard<mutex> samplesLock(samples->lock);
+		samples->stats.clear();
+	}
+}
+
+//----------------------------------------------------------------------------
+// StateSample
+//----------------------------------------------------------------------------
+StateSample::StateSample(const StateMachine* machine, const StateBase* state) :
+	m_machine(machine), m_state(state), m_start(StateProfiler::ShouldSample() ? StateProfiler::GetTime() : 0)
+{
+	StateProfiler::Count(typeid(*m_machine), typeid(*m_state));
+}
+
+//----------------------------------------------------------------------------
+// Record
+//----------------------------------------------------------------------------
+void StateSample::Record()
+{
+	StateProfiler::Record(typeid(*m_machine), typeid(*m_state), StateProfiler::GetTime() - m_start);
+}
@@ -0,0 +1,116 @@
+#ifndef _STATE_PROFILER_H
+#define _STATE_PROFILER_H
+
+#include "DataTypes.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+class StateMachine;
+class StateBase;
+struct MetricsCounter;
+
+/// @brief Sampling profiler for state actions, cheap enough to leave enabled in 
+/// production.
+///
+/// @details When enabled, each thread times one state action in roughly every N
+/// executed by StateEngine. The distance to the next sample is drawn at random
+/// between 1 and 2N-1 so periodic workloads are not aliased. Sampled time is
+/// attributed to the (machine type, state) pair and scaled by N to estimate the
+/// total. Between samples the cost is a per-thread countdown; when disabled it
+/// is a single relaxed atomic load.
+///
+/// Independent of sampling, every state action is counted exactly per (machine
+/// type, state) pair. Each thread counts into its own table, written without a
+/// lock except when a pair is first seen, and GetStateCounts() merges them.
+class StateProfiler
+{
+public:
+	/// Set the mean number of state actions between samples.
+	/// @param[in] interval - the sample interval N, or 0 to disable sampling.
+	static void SetSampleInterval(UINT32 interval) { m_interval.store(interval, std::memory_order_relaxed); }
+
+	/// Get the mean number of state actions between samples; 0 if disabled.
+	static UINT32 GetSampleInterval() { return m_interval.load(std::memory_order_relaxed); }
+
+	/// Decide whether the calling thread samples the next state action.
+	/// @return TRUE if the state action should be timed and recorded.
+	static bool ShouldSample()
+	{
+		UINT32 interval = m_interval.load(std::memory_order_relaxed);
+		if (interval == 0)
+			return false;
+		if (m_countdown > 1)
+		{
+			m_countdown--;
+			return false;
+		}
+		m_countdown = NextInterval(interval);
+		return true;
+	}
+
+	/// Count an executed state action.
+	/// @param[in] machine - the state machine type.
+	/// @param[in] state - the state object type.
+	static void Count(const std::type_info& machine, const std::type_info& state);
+
+	/// Record a sampled state action.
+	/// @param[in] machine - the state machine type.
+	/// @param[in] state - the state object type.
+	/// @param[in] ns - the state action duration in nanoseconds.
+	static void Record(const std::type_info& machine, const std::type_info& state, std::uint64_t ns);
+
+	/// Get a report of the hottest states by estimated total time.
+	/// @param[in] topN - the maximum number of states listed.
+	/// @return A printable table, one state per line.
+	static std::string GetReport(size_t topN = 10);
+
+	/// Append the number of times each state action has executed, highest first.
+	/// The counts are exact and do not depend on the sample interval. Register 
+	/// with MetricsExporter::CounterCallback to export per-state counts.
+	/// @param[in,out] counters - the counters appended to.
+	static void GetStateCounts(std::vector<MetricsCounter>& counters);
+
+	/// Discard all recorded samples. The state action counts are cumulative and
+	/// are kept.
+	static void Reset();
+
+	/// Get the profiler time in nanoseconds.
+	static std::uint64_t GetTime();
+
+private:
+	static UINT32 NextInterval(UINT32 interval);
+
+	static std::atomic<UINT32> m_interval;
+
+	/// State actions remaining until the calling thread samples again.
+	static inline thread_local UINT32 m_countdown = 0;
+};
+
+/// @brief RAII helper counting one state action and timing it if the profiler 
+/// selects it.
+class StateSample
+{
+public:
+	StateSample(const StateMachine* machine, const StateBase* state);
+
+	~StateSample()
+	{
+		if (m_start != 0)
+			Record();
+	}
+
+private:
+	StateSample(const StateSample&) = delete;
+	StateSample& operator=(const StateSample&) = delete;
+
+	void Record();
+
+	const StateMachine* m_machine;
+	const StateBase* m_state;
+	std::uint64_t m_start;
+};
+
+#endif
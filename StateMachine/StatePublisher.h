@@ -0,0 +1,126 @@
+#ifndef _STATE_PUBLISHER_H
+#define _STATE_PUBLISHER_H
+
+#include "DataTypes.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+class StateMachine;
+
+/// @brief Abstract base called by the state machine engine after each run.
+class StatePublisherBase
+{
+public:
+	/// Called by the state machine engine on the owning thread once an event and
+	/// the internal events it generated have executed, or the run budget yielded.
+	/// @param[in] sm - the state machine instance.
+	/// @param[in] currentState - the current state.
+	virtual void Publish(StateMachine* sm, BYTE currentState) = 0;
+
+protected:
+	virtual ~StatePublisherBase() {}
+};
+
+/// @brief A consistent copy of a machine's state and fields.
+template <class Fields>
+struct PublishedState
+{
+	/// The current state when published.
+	BYTE state;
+
+	/// Incremented on each publish; 0 if nothing was published yet.
+	std::uint64_t version;
+
+	/// The machine fields captured when published.
+	Fields fields;
+};
+
+/// @brief StatePublisher publishes the current state together with selected
+/// machine fields for lock-free observation from other threads. Register an
+/// instance with StateMachine::SetStatePublisher().
+///
+/// @details The owning thread captures the fields with the Capture member
+/// function at the end of each state engine run and stores the state and fields
+/// under a sequence lock. Read() copies them and retries if a publish overlapped,
+/// so observers never block the owning thread and never see the state of one run
+/// with the fields of another. For instance:
+///
+///    struct Status { INT speed; };
+///    void CaptureStatus(Status& status) { status.speed = m_speed; }
+///    StatePublisher<MyMachine, Status, &MyMachine::CaptureStatus> m_status;
+///
+/// Fields must be trivially copyable and should be small; a reader retries for
+/// as long as publishes keep overlapping its copy.
+template <class SM, class Fields, void (SM::*Capture)(Fields&)>
+class StatePublisher : public StatePublisherBase
+{
+	static_assert(std::is_trivially_copyable<Fields>::value, "Fields must be trivially copyable");
+
+public:
+	StatePublisher() : m_sequence(0)
+	{
+		for (auto& word : m_words)
+			word.store(0, std::memory_order_relaxed);
+	}
+
+	/// @see StatePublisherBase::Publish
+	virtual void Publish(StateMachine* sm, BYTE currentState)
+	{
+		std::uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+
+		Payload payload = {};
+		payload.state = currentState;
+		payload.version = sequence / 2 + 1;
+		(static_cast<SM*>(sm)->*Capture)(payload.fields);
+
+		std::uint64_t buffer[WORDS];
+		memcpy(buffer, &payload, sizeof(payload));
+
+		// An odd sequence tells readers a publish is in progress. The payload is
+		// stored as relaxed atomic words so an overlapping read is not a data race.
+		m_sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		for (size_t i = 0; i < WORDS; i++)
+			m_words[i].store(buffer[i], std::memory_order_relaxed);
+		m_sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	/// Read the last published state and fields. Lock-free; may be called from any
+	/// thread.
+	/// @return The published state. The version is 0 if nothing was published yet.
+	PublishedState<Fields> Read() const
+	{
+		std::uint64_t buffer[WORDS];
+		while (1)
+		{
+			std::uint64_t sequence = m_sequence.load(std::memory_order_acquire);
+			if (sequence & 1)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			for (size_t i = 0; i < WORDS; i++)
+				buffer[i] = m_words[i].load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (m_sequence.load(std::memory_order_relaxed) == sequence)
+				break;
+		}
+
+		PublishedState<Fields> published;
+		memcpy(&published, buffer, sizeof(published));
+		return published;
+	}
+
+private:
+	typedef PublishedState<Fields> Payload;
+	static const size_t WORDS = (sizeof(Payload) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+	std::atomic<std::uint64_t> m_sequence;
+	std::atomic<std::uint64_t> m_words[WORDS];
+};
+
+#endif // _STATE_PUBLISHER_H
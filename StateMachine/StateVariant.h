@@ -0,0 +1,86 @@
+#ifndef _STATE_VARIANT_H
+#define _STATE_VARIANT_H
+
+#include "DataTypes.h"
+#include "Fault.h"
+#include <utility>
+#include <variant>
+
+/// @brief Abstract base called by the state machine engine on each state change.
+class StateVariantBase
+{
+public:
+	/// Called by the state machine engine after the current state's exit action
+	/// and before the new state's entry action.
+	/// @param[in] newState - the state being entered.
+	virtual void Transition(BYTE newState) = 0;
+
+protected:
+	virtual ~StateVariantBase() {}
+};
+
+/// @brief StateVariant holds data local to a range of states. Only the data of
+/// the current state is alive; it is default constructed when the machine enters
+/// the range and destroyed when the machine leaves it. Register an instance with
+/// StateMachine::SetStateVariant().
+///
+/// @details Each type argument declares the contiguous states it is alive in
+/// using FIRST_STATE and LAST_STATE enumerators. Ranges must not overlap. For
+/// instance:
+///
+///    struct Spinning
+///    {
+///        enum { FIRST_STATE = ST_ACCELERATION, LAST_STATE = ST_WAIT_FOR_DECELERATION };
+///        INT speed = 0;
+///    };
+///    StateVariant<Spinning> m_stateData;
+///
+/// The instance occupies the size of the largest type plus the variant index,
+/// rather than the sum of every state's members.
+template <class... States>
+class StateVariant : public StateVariantBase
+{
+public:
+	/// @see StateVariantBase::Transition
+	virtual void Transition(BYTE newState)
+	{
+		// The variant index of the type alive in newState; 0 if none
+		size_t index = 0;
+		size_t i = 1;
+		((States::FIRST_STATE <= newState && newState <= States::LAST_STATE ? (index = i, i++) : i++), ...);
+
+		// Remain alive across a transition within the same range
+		if (index != m_data.index())
+			Emplace(index, std::make_index_sequence<sizeof...(States) + 1>());
+	}
+
+	/// Get the current state's data.
+	/// @return A pointer to the data, or NULL if type S is not alive.
+	template <class S>
+	S* Get() { return std::get_if<S>(&m_data); }
+
+	/// Get the current state's data, which must be of type S.
+	/// @return A reference to the data.
+	template <class S>
+	S& Ref()
+	{
+		S* data = Get<S>();
+		ASSERT_TRUE(data != NULL);
+		return *data;
+	}
+
+	/// Check if type S is alive.
+	template <class S>
+	BOOL Is() const { return std::holds_alternative<S>(m_data); }
+
+private:
+	template <size_t... Index>
+	void Emplace(size_t index, std::index_sequence<Index...>)
+	{
+		((Index == index ? (void)m_data.template emplace<Index>() : (void)0), ...);
+	}
+
+	std::variant<std::monostate, States...> m_data;
+};
+
+#endif
@@ -0,0 +1,43 @@
+// Prints the metrics snapshot published by a MetricsExporter.
+//
+// Usage: MetricsReader [shmName] [periodMs]
+//
+// The segment is read without blocking the exporting process. With a period
+// the snapshot is printed repeatedly until the exporter exits.
+
+#include "MetricsExporter.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+	string shmName = argc > 1 ? argv[1] : "/delegate_metrics";
+	int periodMs = argc > 2 ? atoi(argv[2]) : 0;
+
+	MetricsData data;
+	uint64_t lastSnapshot = 0;
+	while (1)
+	{
+		if (!MetricsExporter::Read(shmName, data))
+		{
+			if (lastSnapshot == 0)
+				fprintf(stderr, "No metrics published to %s\n", shmName.c_str());
+			return lastSnapshot == 0 ? 1 : 0;
+		}
+
+		if (data.snapshot != lastSnapshot)
+		{
+			printf("%s\n", MetricsExporter::Format(data).c_str());
+			lastSnapshot = data.snapshot;
+		}
+
+		if (periodMs <= 0)
+			return 0;
+		this_thread::sleep_for(chrono::milliseconds(periodMs));
+	}
+}
@@ -3,6 +3,8 @@
 #include <iostream>
 #include "WorkerThreadStd.h"
 #include "DataTypes.h"
+#include "Tracer.h"
+#include "StateProfiler.h"
 
 // @see https://github.com/endurodave/StateMachineWithModernDelegates
 // David Lafreniere
@@ -10,6 +12,13 @@
 using namespace std;
 using namespace DelegateLib;
 
+// Uncomment to record a Chrome trace of the self-test. Open the file within 
+// chrome://tracing or https://ui.perfetto.dev.
+//#define TRACE_FILE "SelfTestTrace.json"
+
+// Uncomment to sample one in every N state actions and print the hottest states.
+//#define PROFILE_SAMPLE_INTERVAL 4
+
 // A thread to capture self-test status callbacks for output to the "user interface"
 WorkerThread userInterfaceThread("UserInterface");
 
@@ -38,12 +47,20 @@ void SelfTestEngineCompleteCallback()
 //------------------------------------------------------------------------------
 int main(void)
 {	
+#ifdef TRACE_FILE
+	Tracer::Enable(true);
+#endif
+
+#ifdef PROFILE_SAMPLE_INTERVAL
+	StateProfiler::SetSampleInterval(PROFILE_SAMPLE_INTERVAL);
+#endif
+
 	// Create the worker threads
 	userInterfaceThread.CreateThread();
 	SelfTestEngine::GetInstance().GetThread().CreateThread();
 
 	// Register for self-test engine callbacks
-	SelfTestEngine::StatusCallback += MakeDelegate(&SelfTestEngineStatusCallback, userInterfaceThread);
+	SelfTestEngine::StatusTopics.Subscribe("selftest/#", MakeDelegate(&SelfTestEngineStatusCallback, userInterfaceThread));
 	SelfTestEngine::GetInstance().CompletedCallback += MakeDelegate(&SelfTestEngineCompleteCallback, userInterfaceThread);
 	
 #if USE_WIN32_THREADS
@@ -61,13 +78,21 @@ int main(void)
 		std::this_thread::sleep_for(std::chrono::milliseconds(10));
 
 	// Unregister for self-test engine callbacks
-	SelfTestEngine::StatusCallback -= MakeDelegate(&SelfTestEngineStatusCallback, userInterfaceThread);
+	SelfTestEngine::StatusTopics.Unsubscribe("selftest/#", MakeDelegate(&SelfTestEngineStatusCallback, userInterfaceThread));
 	SelfTestEngine::GetInstance().CompletedCallback -= MakeDelegate(&SelfTestEngineCompleteCallback, userInterfaceThread);
 
 	// Exit the worker threads
 	userInterfaceThread.ExitThread();
 	SelfTestEngine::GetInstance().GetThread().ExitThread();
 
+#ifdef TRACE_FILE
+	Tracer::Flush(TRACE_FILE);
+#endif
+
+#ifdef PROFILE_SAMPLE_INTERVAL
+	cout << StateProfiler::GetReport() << endl;
+#endif
+
 	return 0;
 }
 